@@ -7,6 +7,27 @@
 
 #include "./Config/types.hpp"
 
+/**
+ * 이벤트 백엔드를 빌드 시점에 선택한다.
+ * 리눅스에서는 epoll, 그 외(BSD 계열)에서는 kqueue를 사용하며,
+ * GDF_EVENT_EPOLL 또는 GDF_EVENT_KQUEUE를 직접 정의하여 강제할 수 있다.
+ */
+#if !defined(GDF_EVENT_EPOLL) && !defined(GDF_EVENT_KQUEUE)
+#if defined(__linux__)
+#define GDF_EVENT_EPOLL
+#else
+#define GDF_EVENT_KQUEUE
+#endif
+#endif
+
+/**
+ * 리눅스에서는 io_uring 기반의 완료 통지 엔진(CompletionQueue)을 함께 빌드한다.
+ * GDF_EVENT_NO_URING을 정의하면 제외할 수 있다.
+ */
+#if defined(__linux__) && !defined(GDF_EVENT_NO_URING) && !defined(GDF_EVENT_URING)
+#define GDF_EVENT_URING
+#endif
+
 #define IN
 #define OUT
 
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstdio>
+#include <cstring>
 #include <deque>
 #include <map>
 #include <sstream>
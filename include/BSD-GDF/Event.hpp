@@ -2,4 +2,9 @@
 
 #include <BSD-GDF/Event/KernelQueue.hpp>
 #include <BSD-GDF/Event/KernelEvent.hpp>
+#include <BSD-GDF/Event/KernelEventBatch.hpp>
+#include <BSD-GDF/Event/KernelEventHandler.hpp>
+#include <BSD-GDF/Event/KernelQueueStatistics.hpp>
+#include <BSD-GDF/Event/TimerWheel.hpp>
+#include <BSD-GDF/Event/CompletionQueue.hpp>
 
@@ -0,0 +1,237 @@
+/**
+ * @file CompletionQueue.hpp
+ * @author Jeekun Park (jeekunp@naver.com)
+ * @brief io_uring 기반의 완료 통지 I/O 엔진 클래스를 정의
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <sys/socket.h>
+
+#include <BSD-GDF/Config.hpp>
+#include <BSD-GDF/Logger.hpp>
+
+namespace gdf
+{
+
+/**
+ * @brief io_uring으로 accept, recv, send를 커널에 맡기고 완료 결과를 받는 클래스
+ *
+ * KernelQueue가 준비 상태(읽기/쓰기 가능)를 알려준 뒤 다시 recv(), send()를 호출하는 것과 달리,
+ * 요청을 제출 큐에 쌓아 한 번의 io_uring_enter()로 제출하고 그 결과를 완료 큐에서 꺼낸다.\n
+ * accept(주소를 받지 않을 때)와 recv는 multishot으로 등록되어 한 번의 요청으로 여러 번 완료되며,
+ * recv는 미리 커널에 맡겨 둔 버퍼 풀(IORING_OP_PROVIDE_BUFFERS)에서 버퍼를 골라 데이터를 채우므로
+ * 연결마다 recv 버퍼를 둘 필요가 없다.\n
+ * liburing 없이 시스템 콜을 직접 사용하며, 리눅스 6.1 이상을 대상으로 한다.
+ * (GDF_EVENT_URING이 정의되지 않은 환경에서는 Init()이 항상 실패한다)\n
+ * 모든 멤버 함수는 Init()을 호출한 스레드에서만 사용해야 한다.
+ */
+class CompletionQueue
+{
+public:
+    /**
+     * @brief 완료된 요청 하나의 결과
+     */
+    struct Completion
+    {
+        /**
+         * 요청을 제출할 때 지정한 사용자 정의 값
+         */
+        uint64 userData;
+        /**
+         * 시스템 콜의 반환값과 같다. (accept는 새 소켓, recv/send는 바이트 수, 실패시 -errno)
+         */
+        int32 result;
+        /**
+         * multishot 요청이 계속 유지되는지 여부 (false라면 다시 제출해야 한다)
+         */
+        bool bHasMore;
+        /**
+         * recv가 채운 버퍼 (버퍼를 사용하지 않은 완료라면 NULL). 사용 후 ReleaseBuffer()로 돌려주어야 한다.
+         */
+        const char* buffer;
+        /**
+         * buffer의 버퍼 풀 내 번호
+         */
+        uint16 bufferID;
+    };
+
+    /**
+     * @brief CompletionQueue의 기본 생성자
+     */
+    CompletionQueue();
+
+    /**
+     * @brief CompletionQueue의 소멸자
+     */
+    ~CompletionQueue();
+
+    /**
+     * @brief io_uring 인스턴스를 생성하고 recv용 버퍼 풀을 커널에 맡긴다.
+     *
+     * @param entries 제출 큐의 크기 (2의 거듭제곱으로 올림된다)
+     * @param bufferCount 버퍼 풀의 버퍼 개수 (최대 65536)
+     * @param bufferSize 버퍼 하나의 크기
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool Init(const uint32 IN entries = 256, const uint32 IN bufferCount = 1024, const uint32 IN bufferSize = 4096);
+
+    /**
+     * @brief 서버 소켓에 accept 요청을 제출 큐에 넣는다.
+     *
+     * 새 연결마다 result에 클라이언트 소켓을 담은 완료가 발생한다.\n
+     * addr을 지정하지 않으면 multishot으로 등록된다.
+     * addr을 지정하면 커널이 연결마다 같은 주소 버퍼를 덮어쓰지 않도록 한 번만 완료되는 요청으로 등록되며,
+     * 클라이언트의 주소는 완료가 발생한 뒤 addr에서 읽는다. (addr, addrLength는 완료가 발생할 때까지 유효해야 한다)
+     *
+     * @param socket 서버 소켓
+     * @param userData 완료에 함께 반환할 값
+     * @param addr 클라이언트의 주소를 받을 버퍼 (NULL이면 multishot accept)
+     * @param addrLength addr의 크기 (완료 후에는 실제 주소의 크기)
+     * @return true 성공시
+     * @return false 제출 큐에 자리가 없을 시
+     */
+    bool PrepareAccept(const int32 IN socket, const uint64 IN userData,
+                       sockaddr* OUT addr = NULL, socklen_t* OUT addrLength = NULL);
+
+    /**
+     * @brief 소켓에 버퍼 풀을 사용하는 multishot recv 요청을 제출 큐에 넣는다.
+     *
+     * @param socket 대상 소켓
+     * @param userData 완료에 함께 반환할 값
+     * @return true 성공시
+     * @return false 제출 큐에 자리가 없을 시
+     */
+    bool PrepareRecv(const int32 IN socket, const uint64 IN userData);
+
+    /**
+     * @brief 소켓에 send 요청을 제출 큐에 넣는다.
+     *
+     * data는 완료가 발생할 때까지 유효해야 하며 변경되어서는 안 된다.
+     *
+     * @param socket 대상 소켓
+     * @param data 보낼 데이터
+     * @param length 보낼 데이터의 길이
+     * @param userData 완료에 함께 반환할 값
+     * @return true 성공시
+     * @return false 제출 큐에 자리가 없을 시
+     */
+    bool PrepareSend(const int32 IN socket, const void* IN data, const uint32 IN length, const uint64 IN userData);
+
+    /**
+     * @brief 제출 큐에 쌓인 요청을 대기 없이 커널에 제출한다.
+     *
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool Submit();
+
+    /**
+     * @brief 완료 큐에서 다음 완료를 꺼낸다.
+     *
+     * 완료 큐가 비어있다면 쌓인 요청을 제출하면서 완료를 기다리고 false를 반환한다.
+     * (KernelQueue::Poll()과 같은 방식으로 반복 호출한다)
+     *
+     * @param completion 꺼낸 완료를 저장할 구조체
+     * @return true 완료가 존재할 경우
+     * @return false 완료가 존재하지 않을 경우
+     */
+    bool Poll(Completion& OUT completion);
+
+    /**
+     * @brief recv 완료가 사용한 버퍼를 버퍼 풀에 돌려준다.
+     *
+     * 반환 요청은 다음 제출과 함께 커널에 전달되며, 연속된 번호의 반환은 하나의 요청으로 합쳐진다.\n
+     * 제출 큐에 자리가 없어 요청을 넣지 못한 버퍼는 보관했다가 다음 대기(Poll()) 전에 다시 반환하므로 버퍼를 잃지 않는다.
+     *
+     * @param bufferID Completion::bufferID
+     * @return true 반환 요청을 제출 큐에 넣었을 시
+     * @return false 제출 큐에 자리가 없어 반환이 다음 대기로 미루어졌을 시
+     */
+    bool ReleaseBuffer(const uint16 IN bufferID);
+
+    /**
+     * @brief 커널에 맡긴 버퍼 중 아직 recv가 사용하지 않은 버퍼의 개수를 반환한다.
+     *
+     * 제출 전인 반환 요청의 버퍼도 포함한다. (같은 제출에서 뒤에 오는 recv 요청보다 먼저 처리된다)\n
+     * 버퍼 풀이 비어 끝난(-ENOBUFS) recv를 다시 등록할 시점을 판단할 때 사용한다.
+     *
+     * @return uint32 : 사용할 수 있는 버퍼의 개수
+     */
+    uint32 GetAvailableBufferCount() const;
+
+    /**
+     * @brief 완료를 기다리는 최대 시간을 지정한다.
+     *
+     * @param ms 밀리초 단위의 타임아웃 시간
+     */
+    void SetTimeout(const int64 IN ms);
+
+private:
+    CompletionQueue(const CompletionQueue& queue); // = delete
+    const CompletionQueue& operator=(const CompletionQueue& queue); // = delete
+
+    void* getSubmission();
+    bool enter(const uint32 submitCount, const uint32 waitCount);
+    bool provideBuffers(const uint16 bufferID, const uint32 count);
+    bool releaseBuffer(const uint16 bufferID);
+    void retryReleases();
+    void release();
+
+private:
+    enum { BUFFER_GROUP = 0, MAX_BUFFER_COUNT = 65536 };
+    int32 mRingFD;
+    /**
+     * mmap()으로 매핑한 제출 큐, 완료 큐, SQE 배열 영역
+     */
+    void* mSubmitRing;
+    uint64 mSubmitRingSize;
+    void* mCompleteRing;
+    uint64 mCompleteRingSize;
+    void* mSubmissions;
+    uint64 mSubmissionsSize;
+    /**
+     * 커널과 공유하는 링의 head, tail 등 (매핑된 영역 안을 가리킨다)
+     */
+    uint32* mSubmitHead;
+    uint32* mSubmitTail;
+    uint32* mSubmitArray;
+    uint32 mSubmitMask;
+    uint32* mCompleteHead;
+    uint32* mCompleteTail;
+    void* mCompletions;
+    uint32 mCompleteMask;
+    /**
+     * 아직 커널에 제출하지 않은 요청의 개수
+     */
+    uint32 mPendingCount;
+    /**
+     * recv용 버퍼 풀 메모리
+     */
+    char* mBuffers;
+    uint32 mBufferCount;
+    uint32 mBufferSize;
+    /**
+     * 아직 제출되지 않은 마지막 버퍼 반환 요청 (연속된 번호의 반환을 합치기 위해 사용)
+     */
+    void* mLastProvide;
+    /**
+     * 커널에 맡긴 버퍼 중 아직 완료로 돌아오지 않은 버퍼의 개수
+     */
+    uint32 mAvailableBufferCount;
+    /**
+     * 제출 큐에 자리가 없어 아직 반환 요청을 넣지 못한 버퍼 번호
+     */
+    std::vector<uint16> mPendingReleases;
+    int64 mTimeout;
+};
+
+}
@@ -11,20 +11,62 @@
 
 #pragma once
 
-#include <sys/event.h>
 #include <BSD-GDF/Config.hpp>
 
+#if defined(GDF_EVENT_KQUEUE)
+#include <sys/event.h>
+#endif
+
 namespace gdf
 {
 
 /**
  * @brief BSD계열 유닉스 커널의 이벤트를 추상화한 클래스
  * 시스템 내부의 다양한 이벤트(FD,Socket)을 식별하고 이벤트 유형을 파악하는 관리 기능을 제공한다.
+ * 필터와 플래그 값은 백엔드(kqueue, epoll)와 무관하게 eFilter, eFlag로 비교할 수 있다.
  */
 class KernelEvent
 {
 public:
 
+    /**
+     * @enum eFilter
+     * @brief 백엔드와 무관한 이벤트 필터 값
+     *
+     * kqueue 백엔드에서는 EVFILT_* 값과 동일하다.
+     */
+    enum eFilter
+    {
+#if defined(GDF_EVENT_KQUEUE)
+        FilterRead = EVFILT_READ,
+        FilterWrite = EVFILT_WRITE,
+        FilterTimer = EVFILT_TIMER,
+        FilterSignal = EVFILT_SIGNAL,
+#else
+        FilterRead = -1,
+        FilterWrite = -2,
+        FilterSignal = -6,
+        FilterTimer = -7,
+#endif
+    };
+
+    /**
+     * @enum eFlag
+     * @brief 백엔드와 무관한 이벤트 플래그 값
+     *
+     * kqueue 백엔드에서는 EV_EOF, EV_ERROR 값과 동일하다.
+     */
+    enum eFlag
+    {
+#if defined(GDF_EVENT_KQUEUE)
+        FlagEOF = EV_EOF,
+        FlagError = EV_ERROR,
+#else
+        FlagEOF = 0x8000,
+        FlagError = 0x4000,
+#endif
+    };
+
     /**
      * @brief KernelEvent의 기본 생성자
      */
@@ -78,6 +120,34 @@ public:
      */
     bool IsWriteType() const;
 
+    /**
+     * @brief 이 이벤트가 타이머 만료 이벤트인지 식별한다.
+     * @return true 타이머 유형이라면
+     * @return false 타이머 유형이 아니라면
+     */
+    bool IsTimerType() const;
+
+    /**
+     * @brief 이 이벤트가 시그널 이벤트인지 식별한다. 시그널 이벤트의 식별자는 시그널 번호이다.
+     * @return true 시그널 유형이라면
+     * @return false 시그널 유형이 아니라면
+     */
+    bool IsSignalType() const;
+
+    /**
+     * @brief 상대방이 연결을 끊었거나 fd가 더 이상 읽고 쓸 수 없는 상태인지 식별한다.
+     * @return true EOF 상태라면
+     * @return false EOF 상태가 아니라면
+     */
+    bool IsEOF() const;
+
+    /**
+     * @brief 이 이벤트가 오류를 보고하는지 식별한다.
+     * @return true 오류가 발생했다면
+     * @return false 오류가 발생하지 않았다면
+     */
+    bool IsError() const;
+
     /**
      * @brief 이벤트의 식별자를 반환한다.
      * @return uint64 이벤트의 식별자
@@ -0,0 +1,323 @@
+/**
+ * @file KernelEventBatch.hpp
+ * @author Jeekun Park (jeekunp@naver.com)
+ * @brief 커널 이벤트 배열을 복사 없이 순회하기 위한 뷰 클래스를 정의
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <BSD-GDF/Config.hpp>
+#include <BSD-GDF/Event/KernelEvent.hpp>
+
+#if defined(GDF_EVENT_EPOLL)
+#include <sys/epoll.h>
+#else
+#include <sys/event.h>
+#endif
+
+namespace gdf
+{
+
+/**
+ * @brief 커널이 채워준 이벤트 항목 하나를 그대로 감싼 클래스
+ *
+ * 멤버가 네이티브 이벤트 구조체(struct kevent, struct epoll_event) 하나뿐이며 가상 함수가 없으므로
+ * 네이티브 이벤트 배열을 그대로 KernelEventEntry 배열로 볼 수 있다.\n
+ * 모든 접근자는 인라인으로 네이티브 필드를 직접 읽는다.\n
+ * epoll 백엔드에서는 한 항목이 읽기와 쓰기 준비를 동시에 보고할 수 있다.
+ */
+class KernelEventEntry
+{
+public:
+#if defined(GDF_EVENT_EPOLL)
+    typedef struct epoll_event NativeEvent;
+
+    /**
+     * 타이머 만료, 시그널 항목을 표시하는 epoll 이벤트 비트 (커널이 보고하지 않는 비트를 사용한다)
+     */
+    enum
+    {
+        EpollTimerEvent = 1 << 24,
+        EpollSignalEvent = 1 << 25
+    };
+#else
+    typedef struct kevent NativeEvent;
+#endif
+
+    /**
+     * @brief 이벤트의 식별자(fd)를 반환한다.
+     * @return uint64 이벤트의 식별자
+     */
+    uint64 GetIdentifier() const;
+
+    /**
+     * @brief 주어진 소켓이 이 이벤트와 연관되어 있는지 식별한다.
+     * @param socket 검사할 소켓
+     * @return true 연관되어있을 시
+     * @return false 연관되어있지 않을 시
+     */
+    bool IdentifySocket(const int32 IN socket) const;
+
+    /**
+     * @brief 이 이벤트가 읽기 유형의 이벤트인지 식별한다.
+     * @return true 읽기 유형이라면
+     * @return false 읽기 유형이 아니라면
+     */
+    bool IsReadType() const;
+
+    /**
+     * @brief 이 이벤트가 쓰기 유형의 이벤트인지 식별한다.
+     * @return true 쓰기 유형이라면
+     * @return false 쓰기 유형이 아니라면
+     */
+    bool IsWriteType() const;
+
+    /**
+     * @brief 이 이벤트가 타이머 만료 이벤트인지 식별한다. 타이머 항목의 식별자는 타이머 식별자이다.
+     * @return true 타이머 유형이라면
+     * @return false 타이머 유형이 아니라면
+     */
+    bool IsTimerType() const;
+
+    /**
+     * @brief 이 이벤트가 시그널 이벤트인지 식별한다. 시그널 항목의 식별자는 시그널 번호이다.
+     * @return true 시그널 유형이라면
+     * @return false 시그널 유형이 아니라면
+     */
+    bool IsSignalType() const;
+
+    /**
+     * @brief 상대방이 연결을 끊었거나 fd가 더 이상 읽고 쓸 수 없는 상태인지 식별한다.
+     * @return true EOF 상태라면
+     * @return false EOF 상태가 아니라면
+     */
+    bool IsEOF() const;
+
+    /**
+     * @brief 이 이벤트가 오류를 보고하는지 식별한다.
+     * @return true 오류가 발생했다면
+     * @return false 오류가 발생하지 않았다면
+     */
+    bool IsError() const;
+
+    /**
+     * @brief 필터에 의해 반환된 데이터를 반환한다. (epoll 백엔드에서는 항상 0)
+     * @return int64 필터에 의해 반환된 데이터
+     */
+    int64 GetData() const;
+
+    /**
+     * @brief 네이티브 이벤트 구조체를 반환한다.
+     * @return const NativeEvent& 네이티브 이벤트 구조체의 참조
+     */
+    const NativeEvent& GetNativeEvent() const;
+
+private:
+    NativeEvent mNative;
+};
+
+/**
+ * @brief KernelQueue의 이벤트 배열 위에 놓인 읽기 전용 범위
+ *
+ * 이벤트를 복사하지 않고 KernelQueue 내부 배열을 직접 가리킨다.\n
+ * 다음 Poll() 또는 PollBatch() 호출 전까지만 유효하다.
+ */
+class KernelEventBatch
+{
+public:
+    typedef const KernelEventEntry* ConstIterator;
+
+    /**
+     * @brief 빈 범위를 만드는 기본 생성자
+     */
+    KernelEventBatch();
+
+    /**
+     * @brief 주어진 배열을 가리키는 범위를 만드는 생성자
+     * @param begin 배열의 첫 항목
+     * @param size 항목의 개수
+     */
+    KernelEventBatch(const KernelEventEntry* IN begin, const uint64 IN size);
+
+    /**
+     * @brief 첫 항목을 가리키는 반복자를 반환한다.
+     * @return ConstIterator 첫 항목의 포인터
+     */
+    ConstIterator Begin() const;
+
+    /**
+     * @brief 마지막 항목의 다음을 가리키는 반복자를 반환한다.
+     * @return ConstIterator 마지막 항목 다음의 포인터
+     */
+    ConstIterator End() const;
+
+    /**
+     * @brief 범위에 포함된 항목의 개수를 반환한다.
+     * @return uint64 항목의 개수
+     */
+    uint64 Size() const;
+
+    /**
+     * @brief 범위가 비어있는지 확인한다.
+     * @return true 비어있다면
+     * @return false 항목이 있다면
+     */
+    bool Empty() const;
+
+    /**
+     * @brief index번째 항목을 반환한다.
+     * @param index 항목의 위치
+     * @return const KernelEventEntry& 항목의 참조
+     */
+    const KernelEventEntry& operator[](const uint64 IN index) const;
+
+private:
+    const KernelEventEntry* mBegin;
+    uint64 mSize;
+};
+
+#if defined(GDF_EVENT_EPOLL)
+
+inline uint64 KernelEventEntry::GetIdentifier() const
+{
+    if (mNative.events & (EpollTimerEvent | EpollSignalEvent))
+    {
+        return mNative.data.u64;
+    }
+    return static_cast<uint64>(mNative.data.fd);
+}
+
+inline bool KernelEventEntry::IsReadType() const
+{
+    return (mNative.events & (EPOLLIN | EPOLLRDHUP | EPOLLPRI | EPOLLHUP | EPOLLERR)) != 0;
+}
+
+inline bool KernelEventEntry::IsWriteType() const
+{
+    return (mNative.events & EPOLLOUT) != 0;
+}
+
+inline bool KernelEventEntry::IsTimerType() const
+{
+    return (mNative.events & EpollTimerEvent) != 0;
+}
+
+inline bool KernelEventEntry::IsSignalType() const
+{
+    return (mNative.events & EpollSignalEvent) != 0;
+}
+
+inline bool KernelEventEntry::IsEOF() const
+{
+    return (mNative.events & (EPOLLHUP | EPOLLRDHUP)) != 0;
+}
+
+inline bool KernelEventEntry::IsError() const
+{
+    return (mNative.events & EPOLLERR) != 0;
+}
+
+inline int64 KernelEventEntry::GetData() const
+{
+    return 0;
+}
+
+#else
+
+inline uint64 KernelEventEntry::GetIdentifier() const
+{
+    return static_cast<uint64>(mNative.ident);
+}
+
+inline bool KernelEventEntry::IsReadType() const
+{
+    return mNative.filter == EVFILT_READ;
+}
+
+inline bool KernelEventEntry::IsWriteType() const
+{
+    return mNative.filter == EVFILT_WRITE;
+}
+
+inline bool KernelEventEntry::IsTimerType() const
+{
+    return mNative.filter == EVFILT_TIMER;
+}
+
+inline bool KernelEventEntry::IsSignalType() const
+{
+    return mNative.filter == EVFILT_SIGNAL;
+}
+
+inline bool KernelEventEntry::IsEOF() const
+{
+    return (mNative.flags & EV_EOF) != 0;
+}
+
+inline bool KernelEventEntry::IsError() const
+{
+    return (mNative.flags & EV_ERROR) != 0;
+}
+
+inline int64 KernelEventEntry::GetData() const
+{
+    return static_cast<int64>(mNative.data);
+}
+
+#endif
+
+inline bool KernelEventEntry::IdentifySocket(const int32 IN socket) const
+{
+    return GetIdentifier() == static_cast<uint64>(socket);
+}
+
+inline const KernelEventEntry::NativeEvent& KernelEventEntry::GetNativeEvent() const
+{
+    return mNative;
+}
+
+inline KernelEventBatch::KernelEventBatch()
+: mBegin(NULL)
+, mSize(0)
+{
+}
+
+inline KernelEventBatch::KernelEventBatch(const KernelEventEntry* IN begin, const uint64 IN size)
+: mBegin(begin)
+, mSize(size)
+{
+}
+
+inline KernelEventBatch::ConstIterator KernelEventBatch::Begin() const
+{
+    return mBegin;
+}
+
+inline KernelEventBatch::ConstIterator KernelEventBatch::End() const
+{
+    return mBegin + mSize;
+}
+
+inline uint64 KernelEventBatch::Size() const
+{
+    return mSize;
+}
+
+inline bool KernelEventBatch::Empty() const
+{
+    return mSize == 0;
+}
+
+inline const KernelEventEntry& KernelEventBatch::operator[](const uint64 IN index) const
+{
+    return mBegin[index];
+}
+
+} // namespace gdf
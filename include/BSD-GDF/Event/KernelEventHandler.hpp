@@ -0,0 +1,46 @@
+/**
+ * @file KernelEventHandler.hpp
+ * @author Jeekun Park (jeekunp@naver.com)
+ * @brief fd에 연결되어 커널 이벤트를 직접 전달받는 처리기 인터페이스를 정의
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <BSD-GDF/Config.hpp>
+#include <BSD-GDF/Event/KernelEvent.hpp>
+
+namespace gdf
+{
+
+/**
+ * @brief KernelQueue에 fd와 함께 등록되어 이벤트를 직접 전달받는 처리기
+ *
+ * 처리기 포인터는 kqueue 백엔드에서는 kevent의 udata에, epoll 백엔드에서는 fd로 인덱싱되는 등록 표에 저장되므로
+ * 이벤트마다 fd로 세션 목록을 검색할 필요가 없다.\n
+ * 처리기는 읽기/쓰기 이벤트마다 따로 등록되며, 감시를 제거하거나 fd를 close()한 뒤에도
+ * 그 대기에서 받은 이벤트가 모두 전달될 때까지(KernelQueue::Poll()이 false를 반환할 때까지) 유효해야 한다.
+ * (HandleEvent() 안에서 fd를 닫았다면 처리기의 해제는 그 이후로 미룬다)\n
+ * 처리기를 등록한 fd는 close() 전에 DeleteReadEvent()/DeleteWriteEvent()로 감시를 제거해야 한다.
+ */
+class KernelEventHandler
+{
+public:
+    /**
+     * @brief KernelEventHandler의 소멸자
+     */
+    virtual ~KernelEventHandler() {}
+
+    /**
+     * @brief 처리기가 등록된 fd에 이벤트가 발생했을 때 KernelQueue::Poll() 안에서 호출된다.
+     *
+     * @param event 발생한 이벤트
+     */
+    virtual void HandleEvent(const KernelEvent& IN event) = 0;
+};
+
+}
@@ -12,13 +12,20 @@
 #pragma once
 
 #include <new>
+#include <cerrno>
 #include <ctime>
 #include <cstring>
+#include <csignal>
 #include <unistd.h>
-#include <sys/event.h>
 
 #include <BSD-GDF/Config.hpp>
 #include <BSD-GDF/Logger.hpp>
+#include <BSD-GDF/Event/KernelEventBatch.hpp>
+#include <BSD-GDF/Event/KernelEventHandler.hpp>
+#include <BSD-GDF/Event/KernelQueueStatistics.hpp>
+#include <BSD-GDF/Event/TimerWheel.hpp>
+
+#include <vector>
 
 namespace gdf
 {
@@ -27,12 +34,33 @@ class KernelEvent;
 
 /**
  * @brief 커널 이벤트 큐를 관리하는 클래스이다.
- * 이 클래스는 시스템 커널 레벨의 이벤트 핸들링을 위해 kqueue를 사용한다.
+ * 이 클래스는 시스템 커널 레벨의 이벤트 핸들링을 위해 kqueue를 사용한다.\n
+ * 리눅스에서는 같은 API 뒤에서 epoll을 사용하며, 백엔드는 빌드 시점에 Config.hpp에서 선택된다.\n
+ * Post()와 Wakeup()을 제외한 멤버 함수는 이벤트 루프를 실행하는 스레드에서만 호출해야 한다.
  */
 class KernelQueue
 {
 public:
 
+    /**
+     * @brief Post()로 전달하는 작업 함수의 형식
+     */
+    typedef void (*TaskFunction)(void* arg);
+
+    /**
+     * @enum eMode
+     * @brief 이벤트 등록 모드 (비트 OR로 조합할 수 있다)
+     *
+     * epoll 백엔드에서는 모드가 fd 단위로 적용되므로, 한 fd의 읽기/쓰기는 같은 모드로 등록해야 한다.
+     * 다른 방향이 등록(또는 비활성화)된 상태에서 다른 모드로 Add/Modify하면 FAILURE를 반환한다.
+     */
+    enum eMode
+    {
+        ModeLevel = 0,      // 준비 상태가 유지되는 동안 매 대기마다 보고 (기본값)
+        ModeEdge = 1,       // 상태가 바뀔 때만 보고 (EV_CLEAR, EPOLLET)
+        ModeOneShot = 2,    // 한 번 보고한 뒤 비활성화 (EV_ONESHOT, EPOLLONESHOT), Modify로 다시 활성화
+    };
+
     /**
      * @brief KernelQueue의 기본 생성자
      */
@@ -54,49 +82,422 @@ public:
     /**
      * @brief 읽기 이벤트를 추가하여 해당 fd를 감시한다.
      * 
+     * 등록은 변경 목록에 쌓였다가 다음 대기(Poll, PollBatch)와 함께 한 번의 시스템 콜로 제출된다.\n
+     * 즉시 반영되어야 한다면 Flush()를 호출한다.
+     *
      * @param fd 감시할 파일 디스크립터
+     * @param mode 등록 모드 (eMode 조합)
+     * @param handler 이벤트를 직접 전달받을 처리기 (NULL이면 Poll()이 이벤트를 반환한다, 읽기/쓰기 이벤트마다 따로 지정된다)
      * @return true 성공시
      * @return false 실패시
      */
-    bool AddReadEvent(const int32 fd);
+    bool AddReadEvent(const int32 fd, const int32 mode = ModeLevel, KernelEventHandler* handler = NULL);
 
     /**
      * @brief 쓰기 이벤트를 추가하여 해당 fd를 감시한다.
      * 
+     * 등록은 변경 목록에 쌓였다가 다음 대기(Poll, PollBatch)와 함께 한 번의 시스템 콜로 제출된다.\n
+     * 즉시 반영되어야 한다면 Flush()를 호출한다.
+     *
      * @param fd 감시할 파일 디스크립터
+     * @param mode 등록 모드 (eMode 조합)
+     * @param handler 이벤트를 직접 전달받을 처리기 (NULL이면 Poll()이 이벤트를 반환한다, 읽기/쓰기 이벤트마다 따로 지정된다)
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool AddWriteEvent(const int32 fd, const int32 mode = ModeLevel, KernelEventHandler* handler = NULL);
+
+    /**
+     * @brief 읽기 이벤트의 등록 모드를 바꾼다. ModeOneShot으로 한 번 보고된 이벤트를 다시 활성화할 때도 사용한다.
+     *
+     * @param fd 대상 파일 디스크립터
+     * @param mode 새 등록 모드 (eMode 조합)
+     * @param handler 이벤트를 직접 전달받을 처리기 (등록 시 지정한 처리기를 다시 넘겨야 한다, NULL이면 이 이벤트의 처리기가 해제된다)
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool ModifyReadEvent(const int32 fd, const int32 mode, KernelEventHandler* handler = NULL);
+
+    /**
+     * @brief 쓰기 이벤트의 등록 모드를 바꾼다. ModeOneShot으로 한 번 보고된 이벤트를 다시 활성화할 때도 사용한다.
+     *
+     * @param fd 대상 파일 디스크립터
+     * @param mode 새 등록 모드 (eMode 조합)
+     * @param handler 이벤트를 직접 전달받을 처리기 (등록 시 지정한 처리기를 다시 넘겨야 한다, NULL이면 이 이벤트의 처리기가 해제된다)
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool ModifyWriteEvent(const int32 fd, const int32 mode, KernelEventHandler* handler = NULL);
+
+    /**
+     * @brief 읽기 이벤트 감시를 제거한다.
+     *
+     * fd를 close()하면 커널의 등록은 자동으로 제거되지만, epoll 백엔드의 fd별 등록 표는 close()를 알 수 없다.\n
+     * 처리기나 ModeLevel 이외의 모드로 등록했거나, 이벤트를 비활성화했거나, 등록이 아직 제출되지 않은 fd는
+     * close() 전에 읽기/쓰기 감시를 모두 제거해야 한다. (같은 번호로 재사용된 fd에 이전 처리기나 모드가 남지 않도록)\n
+     * 그 밖의 fd는 재사용 시 등록 표가 다시 맞춰지므로 호출할 필요가 없다.
+     *
+     * @param fd 대상 파일 디스크립터
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool DeleteReadEvent(const int32 fd);
+
+    /**
+     * @brief 쓰기 이벤트 감시를 제거한다.
+     *
+     * fd를 close()하면 커널의 등록은 자동으로 제거되지만, epoll 백엔드의 fd별 등록 표는 close()를 알 수 없다.\n
+     * 처리기나 ModeLevel 이외의 모드로 등록했거나, 이벤트를 비활성화했거나, 등록이 아직 제출되지 않은 fd는
+     * close() 전에 읽기/쓰기 감시를 모두 제거해야 한다. (같은 번호로 재사용된 fd에 이전 처리기나 모드가 남지 않도록)\n
+     * 그 밖의 fd는 재사용 시 등록 표가 다시 맞춰지므로 호출할 필요가 없다.
+     *
+     * @param fd 대상 파일 디스크립터
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool DeleteWriteEvent(const int32 fd);
+
+    /**
+     * @brief 비활성화된 읽기 이벤트를 다시 활성화한다.
+     *
+     * @param fd 대상 파일 디스크립터
      * @return true 성공시
      * @return false 실패시
      */
-    bool AddWriteEvent(const int32 fd);
+    bool EnableReadEvent(const int32 fd);
+
+    /**
+     * @brief 등록은 유지한 채로 읽기 이벤트 보고를 멈춘다.
+     *
+     * @param fd 대상 파일 디스크립터
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool DisableReadEvent(const int32 fd);
+
+    /**
+     * @brief 비활성화된 쓰기 이벤트를 다시 활성화한다.
+     *
+     * 보낼 데이터가 생겼을 때 호출하고, 다 보낸 뒤에는 DisableWriteEvent()로 멈추면
+     * 유휴 연결이 불필요하게 루프를 깨우지 않는다.
+     *
+     * @param fd 대상 파일 디스크립터
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool EnableWriteEvent(const int32 fd);
+
+    /**
+     * @brief 등록은 유지한 채로 쓰기 이벤트 보고를 멈춘다.
+     *
+     * @param fd 대상 파일 디스크립터
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool DisableWriteEvent(const int32 fd);
+
+    /**
+     * @brief 시그널 이벤트를 추가하여 해당 시그널을 Poll(), PollBatch()로 전달받는다.
+     *
+     * 이벤트의 식별자는 시그널 번호이다.\n
+     * kqueue 백엔드에서는 EVFILT_SIGNAL을 사용하며 시그널의 기본 동작을 무시(SIG_IGN)로 바꾼다.
+     * epoll 백엔드에서는 signalfd를 사용하며 호출한 스레드의 시그널 마스크에서 해당 시그널을 막는다.
+     * (다른 스레드가 시그널을 받지 않도록, 스레드를 만들기 전에 호출해야 한다)
+     *
+     * @param signal 감시할 시그널 번호 (SIGTERM, SIGHUP, SIGUSR1, SIGRTMIN ~ SIGRTMAX 등)
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool AddSignalEvent(const int32 signal);
+
+    /**
+     * @brief 시그널 이벤트 감시를 제거하고 시그널의 기본 동작을 되돌린다.
+     *
+     * @param signal 대상 시그널 번호
+     * @return true 성공시
+     * @return false 실패시
+     */
+    bool DeleteSignalEvent(const int32 signal);
+
+    /**
+     * @brief 변경 목록에 쌓인 등록을 대기 없이 즉시 커널에 제출한다.
+     *
+     * kqueue 백엔드에서는 EV_RECEIPT를 사용하여 항목마다 성공 여부를 확인하고, 실패한 항목을 로그로 남긴다.
+     *
+     * @return true 모든 항목이 성공했을 시
+     * @return false 하나 이상의 항목이 실패했을 시
+     */
+    bool Flush();
     
     /**
      * @brief 이벤트 큐를 폴링하고 다음 이벤트를 반환한다.
-     * 
+     *
+     * 처리기가 등록된 fd의 이벤트는 반환하지 않고 그 자리에서 KernelEventHandler::HandleEvent()로 전달한다.\n
+     * 한 번의 대기에서 받은 같은 fd의 이벤트가 이어서 전달될 수 있으므로, 처리기는 false를 반환할 때까지 유효해야 한다.
+     *
      * @param event 반환할 KernelEvent 객체의 참조
      * @return true 이벤트가 존재할 경우
      * @return false 이벤트가 존재하지 않을 경우
      */
     bool Poll(KernelEvent& event);
 
+    /**
+     * @brief 이벤트 큐를 한 번 대기하고, 준비된 이벤트 전체를 복사 없이 반환한다.
+     *
+     * 반환된 범위는 내부 이벤트 배열을 직접 가리키며, 다음 Poll() 또는 PollBatch() 호출 전까지만 유효하다.\n
+     * Poll()로 소비하지 않은 이벤트가 남아있다면 대기하지 않고 남은 이벤트를 반환한다.\n
+     * 처리기는 사용하지 않는다. 처리기가 등록된 fd의 이벤트도 전달되지 않고 그대로 범위에 포함되며,
+     * epoll 백엔드에서는 항목에서 처리기를 다시 찾을 수 없으므로 처리기를 등록했다면 Poll()을 사용한다.
+     * 
+     * @return KernelEventBatch 준비된 이벤트의 범위 (이벤트가 없거나 오류시 빈 범위)
+     */
+    KernelEventBatch PollBatch();
+
+    /**
+     * @brief 마지막 대기에서 받은 이벤트 중 아직 꺼내지 않은 이벤트가 남아있는지 확인한다.
+     *
+     * false라면 다음 Poll() 호출이 대기하므로, 한 바퀴가 끝날 때 할 일(모아둔 데이터 전송 등)을 대기 전에 처리할 수 있다.
+     *
+     * @return true 남은 이벤트가 있을 시
+     * @return false 남은 이벤트가 없을 시
+     */
+    bool HasPendingEvents() const;
+
+    /**
+     * @brief 타이머를 추가한다.
+     *
+     * 타이머가 만료되면 I/O 이벤트와 같은 Poll(), PollBatch() 경로로 타이머 유형의 이벤트가 전달된다.\n
+     * 이벤트의 식별자는 타이머 식별자이며, 사용자 정의 포인터는 udata이다.\n
+     * 대기 시간은 SetTimeout()으로 지정한 값과 가장 가까운 만료 시각 중 짧은 쪽으로 정해진다.
+     *
+     * @param delay 만료까지의 지연 (ms)
+     * @param interval 반복 주기 (ms), 0이면 한 번만 만료된다.
+     * @param udata 만료 이벤트와 함께 전달할 사용자 정의 포인터
+     * @return TimerWheel::TimerID 추가된 타이머의 식별자
+     */
+    TimerWheel::TimerID AddTimer(const uint64 delay, const uint64 interval = 0, void* udata = NULL);
+
+    /**
+     * @brief 타이머를 취소한다.
+     *
+     * @param id 취소할 타이머의 식별자
+     * @return true 취소했을 시
+     * @return false 이미 만료되었거나 존재하지 않는 타이머일 시
+     */
+    bool CancelTimer(const TimerWheel::TimerID id);
+
+    /**
+     * @brief 다른 스레드에서 이벤트 루프 스레드로 작업을 넘긴다. (스레드 안전)
+     *
+     * 작업은 lock-free MPSC 큐에 쌓이고, 대기 중인 루프를 깨워 다음 Poll(), PollBatch() 안에서
+     * 이벤트를 반환하기 전에 넣은 순서대로 실행된다.
+     *
+     * @param function 루프 스레드에서 실행할 함수
+     * @param arg function에 전달할 인자
+     * @return true 성공시
+     * @return false Init() 전이거나 메모리 할당 실패시
+     */
+    bool Post(TaskFunction function, void* arg);
+
+    /**
+     * @brief 대기 중인 이벤트 루프를 즉시 깨운다. (스레드 안전)
+     *
+     * kqueue 백엔드에서는 EVFILT_USER, epoll 백엔드에서는 eventfd를 사용하며,
+     * 깨우기 이벤트는 내부에서 소비되어 호출자에게 전달되지 않는다.
+     */
+    void Wakeup();
+
+    /**
+     * @brief 이벤트 배열 크기의 허용 범위를 지정한다. (기본값 128 ~ 1024)
+     *
+     * 이벤트 배열은 대기가 가득 찬 채로 돌아오면 두 배로 늘어나고,
+     * SHRINK_INTERVAL번의 대기 동안 받은 이벤트가 배열의 1/4 이하라면 절반으로 줄어든다.\n
+     * 크기 변경은 다음 대기 직전에 반영된다. minimum과 maximum을 같게 지정하면 크기가 고정된다.
+     *
+     * @param minimum 이벤트 배열의 최소 크기 (1 이상)
+     * @param maximum 이벤트 배열의 최대 크기 (minimum 이상)
+     * @return true 성공시
+     * @return false 범위가 올바르지 않을 시
+     */
+    bool SetEventCapacity(const int32 minimum, const int32 maximum);
+
+    /**
+     * @brief 이벤트 배열의 현재 크기를 반환한다.
+     *
+     * @return int32 이벤트 배열의 크기
+     */
+    int32 GetEventCapacity() const;
+
+    /**
+     * @brief 이벤트 루프의 계측 값을 복사하여 반환한다.
+     *
+     * 계측은 대기마다 시계를 두 번 읽는 것이 전부이며, 이벤트당 추가 비용은 없다.\n
+     * 다른 스레드에서 읽어야 한다면 Post()로 넘긴 작업 안에서 호출한다.
+     *
+     * @param statistics 계측 값을 저장할 구조체
+     */
+    void GetStatistics(KernelQueueStatistics& OUT statistics) const;
+
+    /**
+     * @brief 계측 값을 0으로 초기화한다.
+     */
+    void ResetStatistics();
+
     /**
      * @brief 이벤트가 발생할 때까지 함수가 얼마나 대기할지 지정한다.
      * 
      * @param ms 밀리초 단위의 타임아웃 시간
      */
     void SetTimeout(const int64 ms);
+
+    /**
+     * @brief SetTimeout()으로 지정한 대기 시간을 반환한다.
+     *
+     * @return int64 밀리초 단위의 타임아웃 시간
+     */
+    int64 GetTimeout() const;
 private:
     KernelQueue(const KernelQueue& event); // = delete
     const KernelQueue& operator=(const KernelQueue& event); // = delete
     
+    typedef KernelEventEntry::NativeEvent NativeEvent;
+
     bool createKqueue();
-    const struct kevent* getEventList();
+    const NativeEvent* getEventList();
+    int32 waitEvents(const int32 capacity, const int64 timeout);
+    void translateEvent(KernelEvent& event);
+    void translateTimerEvent(KernelEvent& event);
+    void appendTimerEvents();
+    void fillTimerEvent(NativeEvent& native, const TimerWheel::TimerID id, void* udata);
+    bool createWakeup();
+    void triggerWakeup();
+    void runTasks();
+    void recordWait(const uint64 waitStart, const uint64 waitEnd, const int32 capacity);
+    void adjustEventCapacity();
+    bool resizeEventList(const int32 capacity);
+#if defined(GDF_EVENT_EPOLL)
+    enum eInterestOp { InterestAdd, InterestModify, InterestDelete, InterestEnable, InterestDisable };
+    bool changeInterest(const int32 fd, const uint32 interest, const eInterestOp op, const int32 mode,
+                        KernelEventHandler* handler);
+    bool applyInterest(const int32 fd);
+    struct Interest;
+    static void setHandler(Interest& current, const uint32 interest, KernelEventHandler* handler);
+    void readSignals();
+    int32 appendSignalEvents(const int32 eventCount, const int32 capacity);
+#else
+    bool changeEvent(const int32 fd, const int16 filter, const uint16 flags, const int32 mode,
+                     KernelEventHandler* handler);
+    void queueChange(const struct kevent& change);
+#endif
 private:
-    enum { MAX_KEVENT_SIZE = 128 };
+    enum
+    {
+        DEFAULT_MIN_EVENT_CAPACITY = 128,
+        DEFAULT_MAX_EVENT_CAPACITY = 1024,
+        /**
+         * 이벤트 배열을 줄일지 판단하는 대기 횟수
+         */
+        SHRINK_INTERVAL = 64
+    };
+    /**
+     * kqueue 백엔드에서는 kqueue fd, epoll 백엔드에서는 epoll fd
+     */
     int32 mKqueue;
-    struct kevent* mEventList;
+    NativeEvent* mEventList;
+    /**
+     * 이벤트 배열의 현재 크기와 허용 범위
+     */
+    int32 mEventCapacity;
+    int32 mMinEventCapacity;
+    int32 mMaxEventCapacity;
+    /**
+     * 최근 SHRINK_INTERVAL번의 대기 중 가장 많이 받은 이벤트 수와 그 대기 횟수
+     */
+    int32 mPeakEventCount;
+    int32 mShrinkCountdown;
+    /**
+     * 직전 대기가 이벤트 배열을 가득 채워 돌아왔는지 나타내는 값
+     */
+    bool bIsSaturated;
     int32 mEventCount;
     int32 mEventIndex;
-    struct timespec mTimeout;
+    int64 mTimeout;
+    TimerWheel mTimers;
+    /**
+     * 이벤트 목록에서 타이머 이벤트가 시작되는 위치 (커널 이벤트 뒤에 이어 붙는다)
+     */
+    int32 mTimerEventIndex;
+    struct ExpiredTimer
+    {
+        TimerWheel::TimerID id;
+        void* udata;
+    };
+    std::vector<ExpiredTimer> mExpiredTimers;
+    KernelQueueStatistics mStatistics;
+    /**
+     * 직전 대기가 끝난 시각 (ns), 처리 시간 계산에 사용한다.
+     */
+    uint64 mLastWaitEnd;
+    /**
+     * Post()로 넘겨진 작업을 담는 intrusive MPSC 큐의 노드 (Vyukov 방식, mTaskHead는 항상 더미 노드)
+     */
+    struct Task
+    {
+        Task* next;
+        TaskFunction function;
+        void* arg;
+    };
+    Task* mTaskHead;
+    Task* mTaskTail;
+    /**
+     * 깨우기 이벤트가 이미 발생했는지 나타내는 값, 중복된 시스템 콜을 막는다.
+     */
+    int32 mWakeupPending;
+    /**
+     * 이번 대기에서 깨우기 이벤트를 받았는지 나타내는 값
+     */
+    bool bIsWokenUp;
+#if defined(GDF_EVENT_EPOLL)
+    /**
+     * 깨우기에 사용하는 eventfd
+     */
+    int32 mWakeupFD;
+    /**
+     * 시그널을 받는 signalfd와 감시 중인 시그널 집합
+     */
+    int32 mSignalFD;
+    sigset_t mSignalMask;
+    /**
+     * 이벤트 배열이 부족해 아직 전달하지 못한 시그널의 비트 집합 (비트 번호 = 시그널 번호 - 1, SIGRTMAX(64)까지)
+     */
+    uint64 mPendingSignals;
+    /**
+     * epoll은 fd당 하나의 등록만 가지므로 fd별로 원하는 관심 이벤트와 커널에 등록된 관심 이벤트를 기억한다.
+     * (처리기는 kqueue의 필터별 udata처럼 읽기/쓰기를 따로 기억한다)
+     */
+    struct Interest
+    {
+        uint32 events;
+        uint32 disabled;
+        uint32 flags;
+        uint32 registered;
+        uint32 added;
+        bool isChanged;
+        KernelEventHandler* readHandler;
+        KernelEventHandler* writeHandler;
+    };
+    std::vector<Interest> mInterests;
+    /**
+     * 다음 대기 전에 epoll_ctl()로 반영해야 하는 fd 목록 (fd당 한 번만 반영된다)
+     */
+    std::vector<int32> mChangeList;
+#else
+    /**
+     * 다음 kevent() 호출과 함께 제출할 등록 목록
+     */
+    std::vector<struct kevent> mChangeList;
+    std::vector<struct kevent> mReceiptList;
+#endif
 };
  
 }
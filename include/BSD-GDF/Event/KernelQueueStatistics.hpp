@@ -0,0 +1,77 @@
+/**
+ * @file KernelQueueStatistics.hpp
+ * @author Jeekun Park (jeekunp@naver.com)
+ * @brief KernelQueue 이벤트 루프의 계측 값을 담는 구조체를 정의
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <BSD-GDF/Config.hpp>
+
+namespace gdf
+{
+
+/**
+ * @brief KernelQueue 이벤트 루프의 대기 시간, 대기당 이벤트 수, 처리 시간을 모은 스냅샷
+ *
+ * 히스토그램은 log2 구간을 사용한다. 0번 칸은 0, k번 칸은 [2^(k-1), 2^k) 범위의 값을 센다.
+ * (마지막 칸은 그 이상의 값을 모두 포함한다)\n
+ * 시간 단위는 마이크로초이다.
+ */
+struct KernelQueueStatistics
+{
+    enum { HISTOGRAM_SIZE = 32 };
+
+    /**
+     * 커널 대기(kevent(), epoll_wait()) 횟수
+     */
+    uint64 waitCount;
+    /**
+     * 대기에서 받은 커널 이벤트의 총 개수 (타이머 이벤트 제외)
+     */
+    uint64 eventCount;
+    /**
+     * 이벤트 배열이 가득 찬 채로 돌아온 대기 횟수 (준비된 이벤트가 더 남아있었을 수 있다)
+     */
+    uint64 saturatedCount;
+    /**
+     * 대기에 넘긴 이벤트 배열의 크기 (가장 최근 값)
+     */
+    uint64 capacity;
+    /**
+     * 대기에 걸린 시간의 합과 최댓값 (us)
+     */
+    uint64 totalWaitTime;
+    uint64 maxWaitTime;
+    /**
+     * 한 대기가 끝난 뒤 다음 대기를 시작할 때까지 이벤트를 처리한 시간의 합과 최댓값 (us)
+     */
+    uint64 totalDispatchTime;
+    uint64 maxDispatchTime;
+    uint64 waitTimeHistogram[HISTOGRAM_SIZE];
+    uint64 dispatchTimeHistogram[HISTOGRAM_SIZE];
+    uint64 eventCountHistogram[HISTOGRAM_SIZE];
+
+    /**
+     * @brief 값이 속하는 히스토그램 칸을 반환한다.
+     *
+     * @param value 기록할 값
+     * @return int32 히스토그램 칸의 번호
+     */
+    static int32 GetHistogramIndex(const uint64 IN value)
+    {
+        if (value == 0)
+        {
+            return 0;
+        }
+        const int32 index = 64 - __builtin_clzll(value);
+        return (index < HISTOGRAM_SIZE) ? index : HISTOGRAM_SIZE - 1;
+    }
+};
+
+}
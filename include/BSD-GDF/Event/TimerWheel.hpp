@@ -0,0 +1,166 @@
+/**
+ * @file TimerWheel.hpp
+ * @author Jeekun Park (jeekunp@naver.com)
+ * @brief 계층형 타이밍 휠 기반의 타이머 관리 클래스를 정의
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <BSD-GDF/Config.hpp>
+
+namespace gdf
+{
+
+/**
+ * @brief 계층형 타이밍 휠로 다수의 타이머를 관리하는 클래스
+ *
+ * 1ms 단위 틱으로 동작하며, 256칸짜리 첫 단계와 64칸짜리 네 단계로 약 49일까지의 지연을 표현한다.\n
+ * 타이머 추가와 취소는 O(1)이며, 시간이 흐르면 상위 단계의 타이머가 하위 단계로 옮겨진다(cascade).\n
+ * 현재 시각은 호출자가 밀리초 단위로 넘겨주며, 이 클래스는 시계를 직접 읽지 않는다.
+ */
+class TimerWheel
+{
+public:
+    /**
+     * @brief 타이머 식별자. 0은 유효하지 않은 식별자이다.
+     *
+     * 상위 32비트는 세대, 하위 32비트는 슬롯 번호이므로 취소되었거나 만료된 타이머의 식별자는 재사용되지 않는다.
+     */
+    typedef uint64 TimerID;
+
+    /**
+     * @brief TimerWheel의 기본 생성자
+     */
+    TimerWheel();
+
+    /**
+     * @brief TimerWheel의 소멸자
+     */
+    ~TimerWheel();
+
+    /**
+     * @brief 타이머를 추가한다.
+     *
+     * @param now 현재 시각 (ms)
+     * @param delay 만료까지의 지연 (ms)
+     * @param interval 반복 주기 (ms), 0이면 한 번만 만료된다.
+     * @param udata 만료 시 함께 반환할 사용자 정의 포인터
+     * @return TimerID 추가된 타이머의 식별자
+     */
+    TimerID Add(const uint64 IN now, const uint64 IN delay, const uint64 IN interval, void* IN udata);
+
+    /**
+     * @brief 타이머를 취소한다. 만료되었지만 아직 꺼내지 않은 타이머도 취소된다.
+     *
+     * @param id 취소할 타이머의 식별자
+     * @return true 취소했을 시
+     * @return false 이미 만료되었거나 존재하지 않는 타이머일 시
+     */
+    bool Cancel(const TimerID IN id);
+
+    /**
+     * @brief 현재 시각까지 만료된 타이머를 만료 목록으로 옮긴다.
+     *
+     * 반복 타이머는 다음 주기로 다시 예약된다.
+     *
+     * @param now 현재 시각 (ms)
+     */
+    void Advance(const uint64 IN now);
+
+    /**
+     * @brief 만료 목록에서 다음 타이머를 꺼낸다.
+     *
+     * @param id 만료된 타이머의 식별자
+     * @param udata 타이머의 사용자 정의 포인터
+     * @return true 꺼낼 타이머가 있을 시
+     * @return false 만료 목록이 비어있을 시
+     */
+    bool PopExpired(TimerID& OUT id, void*& OUT udata);
+
+    /**
+     * @brief 만료 목록에 남은 타이머의 개수를 반환한다. (취소된 항목이 포함될 수 있다)
+     *
+     * @return uint64 만료 목록의 크기
+     */
+    uint64 GetExpiredCount() const;
+
+    /**
+     * @brief 다음 만료까지 대기해도 되는 시간을 반환한다.
+     *
+     * 상위 단계의 타이머는 cascade 시점까지만 계산하므로 실제 만료 시각보다 이르게 반환될 수 있다.
+     *
+     * @param now 현재 시각 (ms)
+     * @return int64 대기 가능한 시간 (ms), 예약된 타이머가 없으면 -1
+     */
+    int64 GetTimeout(const uint64 IN now) const;
+
+    /**
+     * @brief 예약된 타이머의 개수를 반환한다.
+     *
+     * @return uint64 예약된 타이머의 개수
+     */
+    uint64 GetCount() const;
+
+private:
+    TimerWheel(const TimerWheel& wheel); // = delete
+    const TimerWheel& operator=(const TimerWheel& wheel); // = delete
+
+    enum
+    {
+        ROOT_BITS = 8,
+        LEVEL_BITS = 6,
+        ROOT_SIZE = 1 << ROOT_BITS,
+        LEVEL_SIZE = 1 << LEVEL_BITS,
+        LEVEL_COUNT = 4,
+        SLOT_COUNT = ROOT_SIZE + LEVEL_SIZE * LEVEL_COUNT,
+        BITMAP_COUNT = ROOT_SIZE / 64 + LEVEL_COUNT,
+        NIL = -1
+    };
+
+    enum eState
+    {
+        StateFree = 0,
+        StateScheduled,
+        StateExpired,
+    };
+
+    struct Node
+    {
+        uint64 expires;
+        uint64 interval;
+        void* udata;
+        int32 prev;
+        int32 next;
+        int32 slot;
+        uint32 generation;
+        eState state;
+    };
+
+    int32 allocateNode();
+    void releaseNode(const int32 index);
+    void link(const int32 index);
+    void unlink(const int32 index);
+    void cascade(const int32 level);
+    void expireSlot(const int32 slot);
+    Node* findNode(const TimerID id);
+
+private:
+    std::vector<Node> mNodes;
+    int32 mFreeHead;
+    int32 mHeads[SLOT_COUNT];
+    uint64 mBitmaps[BITMAP_COUNT];
+    uint64 mCurrentTick;
+    uint64 mCount;
+    std::vector<TimerID> mExpired;
+    uint64 mExpiredIndex;
+};
+
+} // namespace gdf
@@ -190,7 +190,8 @@ public:
         /**
          * @brief 스트림에 메세지를 추가하는 연산자 오버로드
          * 
-         * 이 메소드를 통해 다양한 로그 스트림에 대한 데이터 타입의 메세지를 추가할 수 있다.
+         * 이 메소드를 통해 다양한 로그 스트림에 대한 데이터 타입의 메세지를 추가할 수 있다.\n
+         * 출력되지 않을 로그 레벨이라면 메세지를 문자열로 변환하지 않는다.
          *
          * @tparam T 데이터 타입
          * @param message 로그 스트림에 추가할 메세지
@@ -199,11 +200,15 @@ public:
         template <typename T>
         LogStream& operator<<(const T& message)
         {
-            mStream << message;
+            if (bIsEnabled)
+            {
+                mStream << message;
+            }
             return *this;
         }
     private:
         eSeverityLevel mLevel;
+        bool bIsEnabled;
         const char* mFunctionName;
         const char* mFileName;
         const int mLineNumber;
@@ -1,3 +1,10 @@
 #pragma once
 
+#include "./Network/BufferPool.hpp"
+#include "./Network/ByteBuffer.hpp"
+#include "./Network/DelimiterScanner.hpp"
+#include "./Network/SharedBuffer.hpp"
+#include "./Network/SendQueue.hpp"
+#include "./Network/SlowConsumerHandler.hpp"
 #include "./Network/Network.hpp"
+#include "./Network/ReactorGroup.hpp"
@@ -0,0 +1,119 @@
+/**
+ * @file BufferPool.hpp
+ * @author Taeil-Nam (nam0314@gmail.com)
+ * @brief BufferPool 클래스 정의 헤더 파일.
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "../Config.hpp"
+
+namespace gdf
+{
+
+/**
+ * @class BufferPool
+ * @brief 세션 버퍼의 메모리를 크기별(2의 거듭제곱)로 재사용하는 풀 클래스.
+ *
+ * 돌려받은 메모리는 크기별 free list에 보관했다가 같은 크기를 요청할 때 다시 내어준다.
+ * (free list의 연결 포인터는 메모리 블록 안에 저장하므로 추가 메모리를 쓰지 않는다)\n
+ * 보관 중인 메모리가 제한을 넘거나 크기 분류 범위를 벗어나면 바로 해제한다.\n
+ * 내어준 메모리와 보관 중인 메모리의 크기를 기록하므로, 세션 버퍼 전체의 메모리 사용량을 알 수 있다.\n
+ * 잠금을 사용하지 않으므로 한 스레드(Reactor)에서만 사용해야 한다.
+ */
+class BufferPool
+{
+public:
+    /**
+     * @brief 풀에 보관하는 메모리 블록 크기의 범위를 나타내는 상수. (64B ~ 1MB)
+     */
+    enum { kMinClassBits = 6, kMaxClassBits = 20, kClassCount = kMaxClassBits - kMinClassBits + 1 };
+    /**
+     * @brief 풀에 보관하는 메모리의 기본 최대 크기를 나타내는 상수. (16MB)
+     */
+    enum { kDefaultLimit = 16 * 1024 * 1024 };
+
+    /**
+     * @brief BufferPool 객체의 기본 생성자.
+     */
+    BufferPool();
+    /**
+     * @brief BufferPool 객체의 소멸자.
+     *
+     * 보관 중인 메모리를 모두 해제한다.
+     */
+    ~BufferPool();
+
+    /**
+     * @brief capacity 바이트의 메모리 블록을 내어주는 함수.
+     *
+     * @param capacity 블록의 크기. (2의 거듭제곱)
+     * @return char* : 메모리 블록.
+     */
+    char* Allocate(const uint64 IN capacity);
+    /**
+     * @brief Allocate()로 받은 메모리 블록을 돌려주는 함수.
+     *
+     * @param data 메모리 블록. (NULL이면 무시된다)
+     * @param capacity 블록의 크기. (Allocate()에 전달한 값)
+     */
+    void Release(char* IN data, const uint64 IN capacity);
+    /**
+     * @brief 풀에 보관할 메모리의 최대 크기를 설정하는 함수.
+     *
+     * 보관 중인 메모리가 새 제한보다 크다면 모두 해제한다.
+     *
+     * @param limit 보관할 메모리의 최대 크기. (0이면 보관하지 않는다)
+     */
+    void SetLimit(const uint64 IN limit);
+    /**
+     * @brief 보관 중인 메모리를 모두 해제하는 함수.
+     */
+    void Trim();
+    /**
+     * @brief 내어준 뒤 아직 돌려받지 않은 메모리의 크기를 반환하는 함수.
+     *
+     * @return uint64 : 사용 중인 메모리의 크기.
+     */
+    uint64 GetAllocatedMemory() const;
+    /**
+     * @brief 재사용을 위해 보관 중인 메모리의 크기를 반환하는 함수.
+     *
+     * @return uint64 : 보관 중인 메모리의 크기.
+     */
+    uint64 GetPooledMemory() const;
+
+private:
+    BufferPool(const BufferPool& pool); // = delete
+    const BufferPool& operator=(const BufferPool& pool); // = delete
+
+    /**
+     * @brief capacity에 해당하는 free list의 순번을 반환한다. (범위를 벗어나면 -1)
+     */
+    static int32 getClassIndex(const uint64 IN capacity);
+
+private:
+    /**
+     * @brief 크기별 free list의 첫 블록. (각 블록의 앞부분에 다음 블록의 포인터가 저장되어 있다)
+     */
+    char* mFreeLists[kClassCount];
+    /**
+     * @brief 내어준 뒤 아직 돌려받지 않은 메모리의 크기.
+     */
+    uint64 mAllocatedMemory;
+    /**
+     * @brief free list에 보관 중인 메모리의 크기.
+     */
+    uint64 mPooledMemory;
+    /**
+     * @brief free list에 보관할 메모리의 최대 크기.
+     */
+    uint64 mLimit;
+};
+
+}
@@ -0,0 +1,258 @@
+/**
+ * @file ByteBuffer.hpp
+ * @author Taeil-Nam (nam0314@gmail.com)
+ * @brief ByteBuffer 클래스 정의 헤더 파일.
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <sys/uio.h>
+
+#include "../Config.hpp"
+
+namespace gdf
+{
+
+class BufferPool;
+
+/**
+ * @class ByteBuffer
+ * @brief 세션의 송수신 데이터를 저장하는 링 버퍼 클래스.
+ *
+ * 용량은 항상 2의 거듭제곱이며, 데이터는 mHead부터 mSize 바이트만큼 저장되어 있다. (끝에 닿으면 앞으로 이어진다)\n
+ * 앞에서 데이터를 소비(Consume)하는 것은 mHead를 옮기는 것뿐이므로 O(1)이고,
+ * 뒤에 데이터를 추가(Append)하는 것은 용량이 부족할 때만 두 배로 늘리므로 amortized O(1)이다.\n
+ * 데이터가 끝에서 앞으로 이어져 있을 수 있으므로, 연속된 메모리가 필요하다면 GetContiguousData()와
+ * GetContiguousSize()로 앞부분부터 나누어 사용한다.\n
+ * BufferPool이 설정되어 있다면 메모리를 풀에서 받고 풀에 돌려준다.
+ */
+class ByteBuffer
+{
+public:
+    /**
+     * @brief Find()가 패턴을 찾지 못했을 때 반환하는 값.
+     */
+    static const uint64 NPOS = ~static_cast<uint64>(0);
+
+    /**
+     * @brief ByteBuffer 객체의 기본 생성자.
+     *
+     * 메모리는 처음 데이터가 추가될 때 할당한다.
+     */
+    ByteBuffer();
+    /**
+     * @brief ByteBuffer 객체의 복사 생성자.
+     *
+     * @param buffer 복사할 ByteBuffer 객체.
+     */
+    ByteBuffer(const ByteBuffer& buffer);
+    /**
+     * @brief ByteBuffer 객체의 복사 대입 연산자.
+     *
+     * @param buffer 복사할 ByteBuffer 객체.
+     * @return ByteBuffer& : 복사된 ByteBuffer 객체.
+     */
+    ByteBuffer& operator=(const ByteBuffer& buffer);
+    /**
+     * @brief ByteBuffer 객체의 소멸자.
+     */
+    ~ByteBuffer();
+
+    /**
+     * @brief 데이터를 버퍼 뒤에 추가하는 함수.
+     *
+     * @param data 추가할 데이터.
+     * @param size 추가할 데이터의 크기.
+     */
+    void Append(const char* IN data, const uint64 IN size);
+    /**
+     * @brief 버퍼 앞에서 데이터를 소비하는 함수.
+     *
+     * 저장된 데이터보다 큰 값이 주어지면 모든 데이터를 소비한다.
+     *
+     * @param size 소비할 데이터의 크기.
+     */
+    void Consume(const uint64 IN size);
+    /**
+     * @brief 저장된 데이터를 모두 지우는 함수. (메모리는 유지된다)
+     */
+    void Clear();
+    /**
+     * @brief 최소 capacity 바이트를 저장할 수 있도록 메모리를 확보하는 함수.
+     *
+     * @param capacity 확보할 크기.
+     */
+    void Reserve(const uint64 IN capacity);
+    /**
+     * @brief 다른 ByteBuffer와 내용을 교환하는 함수. (메모리를 복사하지 않는다)
+     *
+     * @param buffer 교환할 ByteBuffer 객체.
+     */
+    void Swap(ByteBuffer& IN OUT buffer);
+    /**
+     * @brief 메모리를 받고 돌려줄 BufferPool을 설정하는 함수.
+     *
+     * 할당된 메모리가 없을 때만 설정된다. (다른 곳에서 받은 메모리를 풀에 돌려주지 않도록)
+     *
+     * @param pool 사용할 BufferPool. (NULL이면 new[], delete[]를 사용한다)
+     */
+    void SetPool(BufferPool* IN pool);
+    /**
+     * @brief 저장된 데이터가 없다면 메모리를 해제(또는 풀에 반환)하는 함수.
+     *
+     * 다음에 데이터가 추가될 때 다시 할당한다.
+     */
+    void ReleaseMemory();
+    /**
+     * @brief 저장된 데이터의 크기를 반환하는 함수.
+     *
+     * @return uint64 : 저장된 데이터의 크기.
+     */
+    uint64 Size() const;
+    /**
+     * @brief 저장된 데이터가 없는지 확인하는 함수.
+     *
+     * @return true : 데이터가 없음.
+     * @return false : 데이터가 있음.
+     */
+    bool Empty() const;
+    /**
+     * @brief 할당된 메모리의 크기를 반환하는 함수.
+     *
+     * @return uint64 : 할당된 메모리의 크기.
+     */
+    uint64 Capacity() const;
+    /**
+     * @brief 버퍼 앞에서부터 연속으로 놓인 데이터의 시작 위치를 반환하는 함수.
+     *
+     * @return const char* : 데이터의 시작 위치. (데이터가 없다면 NULL일 수 있다)
+     */
+    const char* GetContiguousData() const;
+    /**
+     * @brief GetContiguousData()에서 연속으로 읽을 수 있는 데이터의 크기를 반환하는 함수.
+     *
+     * @return uint64 : 연속된 데이터의 크기. (데이터가 끝에서 앞으로 이어져 있다면 Size()보다 작다)
+     */
+    uint64 GetContiguousSize() const;
+    /**
+     * @brief 저장된 데이터가 끝에서 앞으로 이어져 있다면, 메모리 안에서 회전시켜 연속으로 만드는 함수.
+     *
+     * 새로 할당하지 않으며, 이미 연속이라면 아무것도 하지 않는다.\n
+     * 호출 후에는 GetContiguousSize()가 Size()와 같다.
+     *
+     * @return const char* : 데이터의 시작 위치. (데이터가 없다면 NULL일 수 있다)
+     */
+    const char* Linearize();
+    /**
+     * @brief 저장된 데이터를 가리키는 iovec을 최대 2개까지 채우는 함수. (writev(), sendmsg()용)
+     *
+     * @param regions 데이터 구간을 저장할 iovec 배열. (2개 이상이어야 한다)
+     * @return uint32 : 채운 iovec의 개수. (데이터가 없다면 0)
+     */
+    uint32 GetReadRegions(struct iovec* OUT regions) const;
+    /**
+     * @brief offset 위치부터 size 바이트를 가리키는 iovec을 최대 2개까지 채우는 함수.
+     *
+     * @param regions 데이터 구간을 저장할 iovec 배열. (2개 이상이어야 한다)
+     * @param offset 시작 위치. (Size() 이하여야 한다)
+     * @param size 구간의 크기. (Size() - offset을 넘으면 끝까지)
+     * @return uint32 : 채운 iovec의 개수.
+     */
+    uint32 GetReadRegions(struct iovec* OUT regions, const uint64 IN offset, const uint64 IN size) const;
+    /**
+     * @brief offset 위치부터 pattern을 찾는 함수.
+     *
+     * 한 바이트 또는 "\r\n" 패턴은 DelimiterScanner의 벡터 명령어 구현으로 찾는다.
+     *
+     * @param pattern 찾을 패턴.
+     * @param patternSize 패턴의 크기.
+     * @param offset 찾기 시작할 위치.
+     * @return uint64 : 패턴이 시작되는 위치. (찾지 못했다면 NPOS 반환)
+     */
+    uint64 Find(const char* IN pattern, const uint64 IN patternSize, const uint64 IN offset = 0) const;
+    /**
+     * @brief 버퍼 앞에서부터 size 바이트를 문자열로 복사하는 함수. (데이터는 소비되지 않는다)
+     *
+     * @param out 데이터를 저장할 문자열.
+     * @param size 복사할 크기.
+     */
+    void CopyTo(std::string& OUT out, const uint64 IN size) const;
+    /**
+     * @brief 버퍼 앞에서부터 size 바이트를 out에 복사하는 함수. (데이터는 소비되지 않는다)
+     *
+     * @param out 데이터를 저장할 메모리. (size 바이트 이상이어야 한다)
+     * @param size 복사할 크기.
+     * @return uint64 : 복사한 크기. (저장된 데이터가 size보다 적다면 Size())
+     */
+    uint64 CopyTo(char* OUT out, const uint64 IN size) const;
+    /**
+     * @brief size 바이트 이상의 빈 공간을 확보하고, 버퍼 뒤의 빈 공간을 가리키는 iovec을 최대 2개까지 채우는 함수.
+     *
+     * readv() 등으로 빈 공간에 직접 데이터를 쓴 뒤, 쓴 만큼 Commit()을 호출한다.
+     *
+     * @param regions 빈 공간을 저장할 iovec 배열. (2개 이상이어야 한다)
+     * @param size 확보할 빈 공간의 최소 크기. (1 이상)
+     * @return uint32 : 채운 iovec의 개수.
+     */
+    uint32 GetWriteRegions(struct iovec* OUT regions, const uint64 IN size);
+    /**
+     * @brief GetWriteRegions()로 얻은 빈 공간에 쓴 데이터를 버퍼에 추가하는 함수.
+     *
+     * @param size 빈 공간에 쓴 데이터의 크기.
+     */
+    void Commit(const uint64 IN size);
+
+private:
+    /**
+     * @brief 최소 capacity 바이트를 저장할 수 있도록 메모리를 다시 할당하고, 데이터를 앞으로 모은다.
+     *
+     * @param capacity 필요한 크기.
+     */
+    void grow(const uint64 IN capacity);
+    /**
+     * @brief capacity 바이트의 메모리를 mPool(없다면 new[])에서 받는다.
+     */
+    char* allocate(const uint64 IN capacity);
+    /**
+     * @brief allocate()로 받은 메모리를 mPool(없다면 delete[])에 돌려준다.
+     */
+    void deallocate(char* IN data, const uint64 IN capacity);
+    /**
+     * @brief 한 바이트 또는 "\r\n" 구분자를 DelimiterScanner로 찾는다.
+     */
+    uint64 findDelimiter(const char* IN pattern, const uint64 IN patternSize, const uint64 IN offset) const;
+    /**
+     * @brief index 위치의 데이터가 pattern과 일치하는지 확인한다.
+     */
+    bool matchAt(const uint64 IN index, const char* IN pattern, const uint64 IN patternSize) const;
+
+private:
+    /**
+     * @brief 데이터를 저장하는 메모리.
+     */
+    char* mData;
+    /**
+     * @brief 할당된 메모리의 크기. (0 또는 2의 거듭제곱)
+     */
+    uint64 mCapacity;
+    /**
+     * @brief 첫 데이터가 저장된 위치.
+     */
+    uint64 mHead;
+    /**
+     * @brief 저장된 데이터의 크기.
+     */
+    uint64 mSize;
+    /**
+     * @brief 메모리를 받고 돌려줄 BufferPool. (NULL이면 new[], delete[]를 사용한다)
+     */
+    BufferPool* mPool;
+};
+
+}
@@ -0,0 +1,53 @@
+/**
+ * @file DelimiterScanner.hpp
+ * @author Taeil-Nam (nam0314@gmail.com)
+ * @brief DelimiterScanner 클래스 정의 헤더 파일.
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "../Config.hpp"
+
+namespace gdf
+{
+
+/**
+ * @class DelimiterScanner
+ * @brief 수신 데이터에서 구분자를 벡터 명령어로 찾는 함수들을 모아놓은 클래스.
+ *
+ * x86-64에서는 CPU가 지원하면 AVX2(32바이트), 아니라면 SSE2(16바이트) 단위로 비교하며,
+ * 그 외의 환경에서는 스칼라 구현을 사용한다. (AVX2 지원 여부는 실행 중에 한 번 확인한다)
+ */
+class DelimiterScanner
+{
+public:
+    /**
+     * @brief [begin, end) 구간에서 byte가 처음 나타나는 위치를 찾는 함수.
+     *
+     * @param begin 구간의 시작.
+     * @param end 구간의 끝.
+     * @param byte 찾을 바이트.
+     * @return const char* : 찾은 위치. (찾지 못했다면 NULL)
+     */
+    static const char* FindByte(const char* IN begin, const char* IN end, const char IN byte);
+    /**
+     * @brief [begin, end) 구간에서 "\r\n"이 처음 나타나는 위치('\r'의 위치)를 찾는 함수.
+     *
+     * @param begin 구간의 시작.
+     * @param end 구간의 끝.
+     * @return const char* : 찾은 위치. (찾지 못했다면 NULL)
+     */
+    static const char* FindCRLF(const char* IN begin, const char* IN end);
+
+private:
+    DelimiterScanner(); // = delete
+};
+
+}
@@ -11,7 +11,10 @@
 
 #pragma once
 
-#include <map>
+#include <vector>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
@@ -22,6 +25,12 @@
 
 #include "../Config.hpp"
 #include <BSD-GDF/Logger.hpp>
+#include <BSD-GDF/Event/CompletionQueue.hpp>
+#include <BSD-GDF/Network/BufferPool.hpp>
+#include <BSD-GDF/Network/ByteBuffer.hpp>
+#include <BSD-GDF/Network/SendQueue.hpp>
+#include <BSD-GDF/Network/SharedBuffer.hpp>
+#include <BSD-GDF/Network/SlowConsumerHandler.hpp>
 
 namespace gdf
 {
@@ -33,11 +42,73 @@ class Network
 {
 private:
     /**
-     * @brief 커널의 receive 버퍼에서 한번에 가져올 수 있는 데이터 크기를 나타내는 상수.
+     * @brief RecvFromClient()의 기본 설정을 나타내는 상수. (readv() 한 번에 확보할 빈 공간 16KB, 호출당 최대 256KB)
      */
-    enum { kRecvBufferSize = 1024 };
+    enum { kDefaultRecvChunkSize = 16 * 1024, kDefaultRecvBudget = 256 * 1024 };
+    /**
+     * @brief 세션이 다음 RecvFromClient()를 위해 기억하는 확보 크기의 상한을 나타내는 상수. (1GB)
+     */
+    enum { kMaxRecvCapacityHint = 1 << 30 };
+    /**
+     * @brief sendmsg() 한 번에 모아 보내는 데이터 구간(iovec)의 최대 개수를 나타내는 상수.
+     */
+    enum { kMaxSendRegions = 64 };
+    /**
+     * @brief ConnectNewClients()가 한 번에 수락하는 클라이언트의 기본 최대 개수를 나타내는 상수.
+     */
+    enum { kDefaultAcceptBatch = 256 };
+    /**
+     * @brief 길이 접두 프레임 모드의 기본 설정을 나타내는 상수. (길이 필드 4바이트, 최대 16MB)
+     */
+    enum { kDefaultFrameLengthSize = 4, kDefaultMaxFrameSize = 16 * 1024 * 1024 };
+    /**
+     * @brief 세션 슬랩의 한 덩어리에 들어가는 세션의 개수를 나타내는 상수. (2의 거듭제곱)
+     */
+    enum { kSessionChunkBits = 8, kSessionChunkSize = 1 << kSessionChunkBits };
+    /**
+     * @brief 구분자 탐색 위치를 기억하는 구분자의 최대 길이를 나타내는 상수. (더 긴 구분자는 매번 처음부터 찾는다)
+     */
+    enum { kMaxScanDelimiterSize = 8 };
+    /**
+     * @brief 완료 통지 모드에서 동시에 제출해 두는 accept 요청의 개수를 나타내는 상수.
+     */
+    enum { kAcceptSlotCount = 16 };
+    /**
+     * @brief 완료 통지 모드에서 accept 요청 하나가 클라이언트의 주소를 받는 구조체.
+     *
+     * multishot accept는 연결마다 같은 주소 버퍼를 덮어쓰므로, 요청마다 따로 두고 완료가 도착하면 같은 슬롯으로 다시 제출한다.
+     */
+    struct AcceptSlot
+    {
+        sockaddr_in addr;
+        socklen_t addrLength;
+    };
+    /**
+     * @brief 완료 통지 모드에서 send 요청 하나가 전송 중인 데이터를 담는 구조체.
+     *
+     * 세션은 send 요청이 진행 중일 때만 가지며, 전송 중에 연결이 종료되면 완료가 도착할 때까지 mOrphanSends에 보관된다.\n
+     * 다 쓴 객체는 mFreeInflightSends로 돌려 재사용하므로, 전송이 반복되어도 새로 할당하지 않는다.
+     */
+    struct InflightSend
+    {
+        /**
+         * @brief send 요청의 사용자 정의 값. (mOrphanSends에 보관될 때 설정한다)
+         */
+        uint64 userData;
+        /**
+         * @brief 커널이 전송 중인 데이터.
+         *
+         * 전송이 완료될 때까지 변경되어서는 안 되므로, 새 데이터는 세션의 sendBuffer에 쌓인다.\n
+         * 보낸 데이터는 완료가 도착할 때마다 앞에서부터 소비된다.
+         */
+        SendQueue queue;
+    };
     /**
      * @brief 네트워크 연결이 완료된 세션의 정보를 저장하는 구조체.
+     *
+     * 슬랩에 미리 만들어 두는 슬롯이므로, 드물게 쓰는 데이터는 밖에 두고 작은 변수를 모아 크기를 줄인다.\n
+     * 유휴 세션 하나가 차지하는 메모리는 이 슬롯 하나로 제한된다. (64비트 환경에서 232바이트, 슬랩은 kSessionChunkSize개씩 늘어난다)
+     * 버퍼의 메모리는 데이터가 있을 때만 풀에서 받고, 비면 돌려준다.
      */
     struct Session
     {
@@ -49,31 +120,162 @@ private:
          * @brief 세션의 소켓.
          */
         int32 socket;
+        /**
+         * @brief 같은 fd를 재사용한 세션을 구별하는 세대 값. (0은 사용하지 않는다)
+         *
+         * 세션이 추가될 때마다 증가하며, SessionHandle과 완료 통지 모드의 사용자 정의 값에 들어간다.
+         */
+        uint32 generation;
+        /**
+         * @brief 세션의 IP 주소 문자열. (연결될 때 한 번만 만든다)
+         */
+        char ipString[INET_ADDRSTRLEN];
         /**
          * @brief 세션이 사용하는 receive buffer.
          */
-        std::string recvBuffer;
+        ByteBuffer recvBuffer;
+        /**
+         * @brief recvBuffer에서 scanDelimiter가 시작될 수 없음이 확인된 위치.
+         *
+         * PullFromRecvBuffer()가 조금씩 도착하는 메세지를 매번 처음부터 다시 찾지 않도록 사용하며,
+         * recvBuffer의 데이터가 소비되면 0으로 초기화된다.
+         */
+        uint64 scanOffset;
+        /**
+         * @brief PeekMessages()가 돌려준 메세지들이 recvBuffer 앞에서 차지하는 크기. (구분자 포함)
+         *
+         * CommitMessages()가 호출되면 이 크기만큼 소비된다.
+         */
+        uint64 peekedSize;
+        /**
+         * @brief 세션이 사용하는 send buffer. (보낸 데이터는 앞에서부터 소비된다)
+         *
+         * 복사된 데이터와 SharedBuffer 참조가 추가된 순서대로 저장된다.
+         */
+        SendQueue sendBuffer;
+        /**
+         * @brief 완료 통지 모드에서 커널이 전송 중인 데이터. (send 요청이 없을 때는 NULL)
+         */
+        struct InflightSend* inflight;
         /**
-         * @brief 세션이 사용하는 send buffer.
+         * @brief 보낼 데이터(sendBuffer + 전송 중인 데이터)의 high watermark. (0이면 제한 없음)
+         */
+        uint64 sendHighWatermark;
+        /**
+         * @brief high watermark를 넘은 세션이 다시 정상으로 돌아오는 low watermark.
+         */
+        uint64 sendLowWatermark;
+        /**
+         * @brief recvBuffer가 비어 메모리를 반환한 뒤, 다음 RecvFromClient()에서 미리 확보할 크기.
+         *
+         * 데이터를 많이 받는 세션은 직전 크기를 유지하고, 적게 받는 세션은 호출마다 절반으로 줄어든다.
          */
-        std::string sendBuffer;
+        uint32 recvCapacityHint;
         /**
-         * @brief 다음에 보내야되는 send buffer의 데이터 위치를 가리키는 인덱스. 
+         * @brief iterationMessages를 센 이벤트 루프 바퀴의 번호. (하위 32비트만 같은지 비교한다)
          */
-        uint64 sendBufferIndex;
+        uint32 budgetIteration;
+        /**
+         * @brief budgetIteration 바퀴에서 가져온 메세지의 개수. (SetMessageBudget()의 제한과 비교한다)
+         */
+        uint32 iterationMessages;
+        /**
+         * @brief scanOffset을 계산할 때 사용한 구분자. (kMaxScanDelimiterSize보다 긴 구분자는 기억하지 않는다)
+         */
+        char scanDelimiter[kMaxScanDelimiterSize];
+        /**
+         * @brief scanDelimiter의 길이. (0이면 기억한 구분자가 없음)
+         */
+        uint8 scanDelimiterSize;
         /**
          * @brief send buffer에 보내야하는 데이터가 남아있는지를 나타내는 변수. 
          */
         bool sendBufferRemain;
+        /**
+         * @brief 세션의 소켓이 FlushSendBuffers()에서 보낼 목록(mFlushList)에 들어가 있는지 나타내는 변수.
+         *
+         * 세션이 종료되어도 목록의 항목은 남으므로, 같은 소켓 번호의 새 세션에서도 초기화하지 않는다.
+         * (소켓마다 항목이 하나뿐이므로 FlushSendBuffers()를 호출하지 않아도 목록이 계속 늘어나지 않는다)
+         */
+        bool isFlushQueued;
         /**
          * @brief 세션이 연결 종료가 예정되어 있는 상태인지 나타내는 변수.
          *
          * 이 변수 값이 true인 경우, 세션은 send buffer에 남아있는 데이터를 다 보낸 뒤 연결을 종료한다.
          */
         bool isReservedDisconnect;
+        /**
+         * @brief 슬롯이 연결된 세션을 담고 있는지 나타내는 변수.
+         */
+        bool isActive;
+        /**
+         * @brief 완료 통지 모드에서 send 요청이 진행 중인지 나타내는 변수.
+         */
+        bool isSending;
+        /**
+         * @brief 보낼 데이터가 high watermark를 넘은 뒤 아직 low watermark 이하로 줄어들지 않았는지 나타내는 변수.
+         */
+        bool isOverHighWatermark;
+        /**
+         * @brief SlowConsumerPauseReads 정책으로 데이터 수신이 멈춘 상태인지 나타내는 변수.
+         */
+        bool isReadPaused;
+        /**
+         * @brief 완료 통지 모드에서 수신이 멈춘 동안 끝난 recv 요청을 다시 등록하지 않았는지 나타내는 변수.
+         */
+        bool isRecvParked;
+        /**
+         * @brief 세션이 다음 바퀴로 넘길 목록(mCarryList)에 들어가 있는지 나타내는 변수.
+         */
+        bool isCarried;
     };
 
 public:
+    /**
+     * @brief 세션을 가리키는 핸들. 0은 유효하지 않은 핸들이다.
+     *
+     * 상위 32비트는 세션의 세대, 하위 32비트는 소켓이므로 연결이 종료된 뒤 같은 fd가 재사용되어도
+     * 이전 연결의 핸들은 새 세션을 가리키지 않는다.
+     */
+    typedef uint64 SessionHandle;
+    /**
+     * @brief 세션의 recvBuffer에 저장된 메세지 하나를 복사 없이 가리키는 구조체.
+     *
+     * 메모리를 소유하지 않으므로, CommitMessages()가 호출되기 전까지만 유효하다.
+     */
+    struct MessageView
+    {
+        /**
+         * @brief 메세지의 시작 위치. (구분자는 포함되지 않는다)
+         */
+        const char* data;
+        /**
+         * @brief 메세지의 크기.
+         */
+        uint64 size;
+    };
+
+    /**
+     * @brief HandleCompletion()이 처리한 완료의 종류.
+     */
+    enum eCompletionResult
+    {
+        CompletionNone = 0,
+        CompletionAccepted,
+        CompletionReceived,
+        CompletionSent,
+        CompletionDisconnected
+    };
+    /**
+     * @brief 세션의 보낼 데이터가 high watermark를 넘었을 때의 처리 방식.
+     */
+    enum eSlowConsumerPolicy
+    {
+        SlowConsumerNotify = 0, // SlowConsumerHandler에 알리기만 한다.
+        SlowConsumerPauseReads, // 알린 뒤 low watermark 이하로 줄어들 때까지 세션의 데이터를 받지 않는다. (준비 상태 통지 모드에서는 처리기가 필요하다)
+        SlowConsumerDisconnect // 알린 뒤 연결을 종료한다.
+    };
+
     /**
      * @brief Network 객체의 기본 생성자.
      *
@@ -84,29 +286,43 @@ public:
      * @brief Network 객체의 소멸자.
      *
      * mServerSocket 멤버 변수를 close 한다.\n
-     * mSessions를 clear 한다.
+     * 세션 슬랩의 메모리를 해제한다.
      */
     ~Network();
 
     /**
      * @brief 서버의 소켓을 생성하고 설정하는 함수.
      * 
-     * private 멤버 함수 createServerSocket(), setServerSocket(port)를 호출한다.
+     * private 멤버 함수 createServerSocket(), setServerSocket(port, bReusePort)를 호출한다.
      *
      * @param port 소켓이 사용할 port number.
+     * @param bReusePort true인 경우, 여러 서버 소켓이 같은 port를 공유하도록 SO_REUSEPORT를 설정한다.
      * @return true : 소켓 생성 및 설정 성공.
      * @return false : 소켓 생성 및 설정 실패.
      */
-    bool Init(const int32 IN port);
+    bool Init(const int32 IN port, const bool IN bReusePort = false);
     /**
      * @brief 클라이언트의 TCP 연결 요청을 수락하는 함수.
      *
-     * 연결이 성공적으로 완료되면, 클라이언트 소켓을 non-blocking으로 설정하고 mSessions에 클라이언트 세션을 추가한 뒤 
+     * 연결이 성공적으로 완료되면, 클라이언트 소켓을 non-blocking으로 설정하고 세션 슬랩에 클라이언트 세션을 추가한 뒤 
      * 연결된 클라이언트 소켓을 반환한다.
      * 
      * @return int32 : 연결된 클라이언트의 소켓. (연결 실패시 -1 반환)
      */
     int32 ConnectNewClient();
+    /**
+     * @brief 대기 중인 클라이언트의 TCP 연결 요청을 한 번에 수락하는 함수.
+     *
+     * 더 이상 대기 중인 연결 요청이 없거나(EAGAIN) maxCount개를 수락할 때까지 반복하며,
+     * 수락한 클라이언트마다 세션을 추가하고 소켓을 sockets 뒤에 추가한다.\n
+     * 가능한 경우 accept4()로 non-blocking, close-on-exec 설정을 수락과 함께 처리한다.\n
+     * 서버 소켓의 읽기 이벤트 한 번에 이 함수를 한 번 호출한다.
+     * 
+     * @param sockets 수락한 클라이언트의 소켓을 추가할 목록.
+     * @param maxCount 한 번에 수락할 최대 개수. (다른 세션의 이벤트 처리가 밀리지 않도록 제한)
+     * @return uint64 : 수락한 클라이언트의 개수.
+     */
+    uint64 ConnectNewClients(std::vector<int32>& OUT sockets, const uint64 IN maxCount = kDefaultAcceptBatch);
     /**
      * @brief 클라이언트와 연결을 종료하는 함수.
      *
@@ -118,22 +334,39 @@ public:
     /**
      * @brief 클라이언트로부터 전송된 데이터를 가져오는 함수.
      * 
-     * 한번에 가져올 수 있는 데이터의 최대 크기는 kRecvBufferSize 이다.\n
-     * recv() 함수를 통해 데이터를 가져오며, 가져온 데이터는 클라이언트 세션의 recvBuffer에 추가된다.
+     * readv() 함수로 클라이언트 세션의 recvBuffer의 빈 공간에 직접 데이터를 받으며, 받은 길이 그대로 추가된다.
+     * (NUL 문자가 포함된 데이터도 잘리지 않는다)\n
+     * 소켓에 더 받을 데이터가 없거나(EAGAIN), 이번 호출에서 받은 데이터가 SetRecvOptions()의 budget에 도달할 때까지 반복한다.
+     * budget에 도달해 소켓에 데이터가 남았을 수 있다면 세션을 다음 바퀴로 넘기므로, TakeCarriedSessions()로 꺼내 이어서 받는다.
+     * (edge-triggered 모드에서도 남은 데이터를 놓치지 않는다)\n
+     * 데이터를 받은 뒤 연결이 끊긴 경우, 받은 데이터를 먼저 반환하고 다음 호출에서 연결을 종료한다.\n
+     * SlowConsumerPauseReads 정책으로 수신이 멈춘 세션이라면 데이터를 받지 않는다.\n
+     * TakeCarriedSessions()를 호출하는 루프에서는, 이번 바퀴에 이미 다음 바퀴로 넘겨진 세션의 데이터도 받지 않는다.
+     * (level-triggered 읽기 이벤트로 한 바퀴에 budget의 두 배를 받지 않도록)
      *
      * @param socket 클라이언트의 소켓.
      * @return true : 데이터 수신 성공.
      * @return false : 클라이언트와 연결이 끊기거나, 오류 발생.
      */
     bool RecvFromClient(const int32 IN socket);
+    /**
+     * @brief RecvFromClient()의 수신 단위와 호출당 수신량 제한을 설정하는 함수.
+     *
+     * 기본값은 kDefaultRecvChunkSize, kDefaultRecvBudget이다.
+     * 
+     * @param chunkSize readv() 한 번을 위해 recvBuffer에 확보할 빈 공간의 최소 크기. (0이면 기본값)
+     * @param budget 한 세션에서 RecvFromClient() 한 번에 받을 수 있는 최대 크기. (한 세션이 이벤트 루프를 독차지하지 않도록 제한, 0이면 기본값)
+     */
+    void SetRecvOptions(const uint64 IN chunkSize, const uint64 IN budget);
     /**
      * @brief 클라이언트에게 데이터를 전송하는 함수.
      * 
      * 클라이언트 세션의 sendBuffer에 데이터가 없는 경우 무시된다.\n
      * 클라이언트 세션의 sendBuffer에 데이터가 없고, 연결 종료 예약이 되어있는 경우 클라이언트와 연결을 종료한다.\n
-     * send() 함수를 통해 데이터를 전송한다.\n
-     * 데이터 전송 후 sendBuffer에 보내야 하는 데이터가 남아있는 경우, sendBufferIndex가 해당 위치를 가리키고 있게된다.\n
-     * 데이터 전송 후 sendBuffer에 데이터가 남아있지 않은 경우, sendBufferIndex를 0으로 초기화한다.
+     * sendmsg() 함수를 통해 sendBuffer의 데이터 구간을 최대 kMaxSendRegions개까지 모아 한 번에 전송하고,
+     * 전송된 만큼 sendBuffer에서 소비한다.\n
+     * 소켓의 send buffer가 가득 찬 경우(EAGAIN)는 오류로 보지 않는다.\n
+     * 데이터 전송 후 sendBuffer에 데이터가 남아있지 않은 경우, sendBufferRemain = false로 설정한다.
      *
      * @param socket 클라이언트의 소켓.
      * @return true : 데이터 전송 완료.
@@ -143,17 +376,147 @@ public:
     /**
      * @brief 클라이언트 세션의 sendBuffer에 데이터를 추가하는 함수.
      *
-     * 클라이언트 세션의 sendBuffer에 데이터를 추가하고, sendBufferRemain = true로 설정한다.
+     * 클라이언트 세션의 sendBuffer에 데이터를 추가하고, sendBufferRemain = true로 설정한다.\n
+     * 바로 전송하지 않으므로, 이벤트 루프 한 바퀴가 끝날 때 FlushSendBuffers()를 호출하면
+     * 그동안 추가된 데이터를 소켓마다 한 번의 시스템 콜로 보낸다.
      * 
      * @param socket 클라이언트의 소켓.
      * @param buf 추가할 데이터.
+     * @return true : 추가 성공.
+     * @return false : 세션이 없음. (또는 SlowConsumerDisconnect 정책으로 연결이 종료됨)
+     */
+    bool PushToSendBuffer(const int32 IN socket, const std::string& IN buf);
+    /**
+     * @brief 클라이언트 세션의 sendBuffer에 size 바이트의 데이터를 추가하는 함수.
+     *
+     * 데이터의 내용(NUL 문자 포함)과 관계없이 size 바이트를 그대로 추가한다.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @param data 추가할 데이터.
+     * @param size 추가할 데이터의 크기.
+     * @return true : 추가 성공.
+     * @return false : 세션이 없음. (또는 SlowConsumerDisconnect 정책으로 연결이 종료됨)
+     */
+    bool PushToSendBuffer(const int32 IN socket, const char* IN data, const uint64 IN size);
+    /**
+     * @brief 클라이언트 세션의 sendBuffer에 데이터를 복사하지 않고 참조만 추가하는 함수.
+     *
+     * 데이터는 전송이 끝날 때까지 SharedBuffer의 참조로 유지되며, sendmsg()가 직접 읽어 보낸다.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @param buffer 추가할 데이터.
+     * @return true : 추가 성공.
+     * @return false : 세션이 없음. (또는 SlowConsumerDisconnect 정책으로 연결이 종료됨)
+     */
+    bool PushToSendBuffer(const int32 IN socket, const SharedBuffer& IN buffer);
+    /**
+     * @brief 여러 클라이언트 세션의 sendBuffer에 같은 데이터를 복사하지 않고 추가하는 함수.
+     *
+     * 데이터는 메모리에 한 번만 존재하며, 각 세션은 참조만 가진다. (세션이 없는 소켓은 무시된다)\n
+     * 전송은 다른 데이터와 마찬가지로 SendToClient() 또는 FlushSendBuffers()에서 이루어진다.
+     * 
+     * @param sockets 클라이언트 소켓의 목록.
+     * @param buffer 보낼 데이터.
+     * @return true : 모든 세션에 추가 성공.
+     * @return false : SlowConsumerDisconnect 정책으로 연결이 종료된 세션이 있음.
+     */
+    bool BroadcastToClients(const std::vector<int32>& IN sockets, const SharedBuffer& IN buffer);
+    /**
+     * @brief 새로 연결되는 세션에 적용할 보낼 데이터의 watermark와 high watermark를 넘었을 때의 정책을 설정하는 함수.
+     *
+     * 보낼 데이터(sendBuffer + 전송 중인 데이터)가 high를 넘으면 SlowConsumerHandler에 알리고 policy대로 처리하며,
+     * 이후 low 이하로 줄어들면 다시 알리고 수신을 재개한다.\n
+     * 느린 클라이언트 하나의 sendBuffer가 끝없이 늘어나지 않도록 제한하는 용도이다. (기본값은 제한 없음)\n
+     * 준비 상태 통지 모드에서 SlowConsumerPauseReads 정책은 SlowConsumerHandler가 등록되어 있을 때만 수신을 멈춘다.
+     * 읽지 않는 소켓의 읽기 이벤트를 처리기가 꺼야 하기 때문이며, 처리기가 없다면 SlowConsumerNotify와 같이 동작한다.
+     * 
+     * @param high high watermark. (0이면 제한 없음)
+     * @param low low watermark. (high 이하)
+     * @param policy high watermark를 넘었을 때의 정책.
+     * @return true : 설정 성공.
+     * @return false : low가 high보다 큼.
+     */
+    bool SetSendWatermarks(const uint64 IN high, const uint64 IN low, const eSlowConsumerPolicy IN policy);
+    /**
+     * @brief 특정 클라이언트 세션의 보낼 데이터 watermark를 설정하는 함수.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @param high high watermark. (0이면 제한 없음)
+     * @param low low watermark. (high 이하)
+     * @return true : 설정 성공.
+     * @return false : 세션이 없거나 low가 high보다 큼.
+     */
+    bool SetSessionSendWatermarks(const int32 IN socket, const uint64 IN high, const uint64 IN low);
+    /**
+     * @brief watermark 알림을 받을 처리기를 설정하는 함수.
+     * 
+     * @param handler 처리기. (NULL이면 알리지 않는다)
+     */
+    void SetSlowConsumerHandler(SlowConsumerHandler* IN handler);
+    /**
+     * @brief 클라이언트 세션의 보낼 데이터 크기를 반환하는 함수.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @return uint64 : sendBuffer와 전송 중인 데이터의 크기. (세션이 없다면 0)
+     */
+    uint64 GetSendQueueSize(const int32 IN socket) const;
+    /**
+     * @brief 클라이언트 세션의 수신이 SlowConsumerPauseReads 정책으로 멈춰 있는지 확인하는 함수.
+     *
+     * 멈춘 동안 RecvFromClient()는 데이터를 받지 않고 true를 반환한다.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @return true : 수신이 멈춰 있음.
+     * @return false : 정상 수신 중. (또는 세션이 없음)
+     */
+    bool IsReadPaused(const int32 IN socket) const;
+    /**
+     * @brief 마지막 FlushSendBuffers() 호출 이후 데이터가 추가된 세션들의 sendBuffer를 전송하는 함수.
+     *
+     * 이벤트 루프 한 바퀴(Poll()로 꺼낸 이벤트 처리)가 끝날 때 호출하면, 그동안 여러 번 추가된 데이터를
+     * 세션마다 SendToClient() 한 번(sendmsg() 한 번)으로 보낸다.\n
+     * 소켓의 send buffer가 가득 차 다 보내지 못한 데이터는 sendBuffer에 남으므로, 쓰기 이벤트에서 SendToClient()로 보낸다.\n
+     * ReactorGroup은 바퀴마다 다음 대기 전에 호출한다.
+     */
+    void FlushSendBuffers();
+    /**
+     * @brief 한 세션에서 이벤트 루프 한 바퀴 동안 가져올 수 있는 메세지의 최대 개수를 설정하는 함수.
+     *
+     * PullFromRecvBuffer(), PullFrameFromRecvBuffer(), PeekMessages()가 가져온 메세지를 세며,
+     * 제한에 도달한 세션은 recvBuffer에 메세지가 남아있어도 false(또는 0)를 반환하고 다음 바퀴로 넘겨진다.\n
+     * 메세지를 쏟아내는 클라이언트 하나가 다른 세션의 처리를 늦추지 않도록 하는 용도이다. (기본값은 0, 제한 없음)
+     * 
+     * @param maxMessages 세션마다 한 바퀴에 가져올 수 있는 메세지의 최대 개수. (0이면 제한 없음)
      */
-    void PushToSendBuffer(const int32 IN socket, const std::string& IN buf);
+    void SetMessageBudget(const uint64 IN maxMessages);
+    /**
+     * @brief 이벤트 루프의 새 바퀴를 시작하고, 이전 바퀴에서 budget을 다 써서 넘겨진 세션들을 꺼내는 함수.
+     *
+     * 세션은 넘겨진 순서대로 sockets 뒤에 추가되며, 이번 바퀴에서 다시 넘겨지면 목록의 뒤로 가므로 round-robin으로 처리된다.\n
+     * 이벤트를 기다리기 전 한 바퀴에 한 번 호출하고, 꺼낸 세션마다 RecvFromClient()와 메세지 처리를 이어서 한다.
+     * 넘겨진 세션의 데이터는 이미 도착해 있으므로, 처리한 뒤 HasCarriedSessions()가 true라면 기다리지 않고 다음 바퀴로 넘어간다.\n
+     * SetMessageBudget()으로 메세지 개수를 제한한다면 반드시 호출해야 한다. (바퀴마다 제한이 초기화되기 때문)
+     * 
+     * @param sockets 넘겨진 세션의 소켓을 추가할 목록.
+     * @return uint64 : 꺼낸 세션의 개수.
+     */
+    uint64 TakeCarriedSessions(std::vector<int32>& OUT sockets);
+    /**
+     * @brief 다음 바퀴로 넘겨진 세션이 있는지 확인하는 함수.
+     *
+     * true라면 다음 대기의 timeout을 0으로 하여, 넘겨진 세션이 timeout만큼 늦게 처리되지 않도록 한다.
+     *
+     * @return true : 넘겨진 세션이 있음. (그 사이 종료된 세션일 수 있다)
+     * @return false : 넘겨진 세션이 없음.
+     */
+    bool HasCarriedSessions() const;
     /**
      * @brief 클라이언트 세션의 recvBuffer에서 데이터를 가져오는 함수.
      *
      * endString 매개 변수를 통해 특정 구분자까지만 데이터를 가져올 수 있으며, 
-     * endString 없이 호출하는 경우 모든 데이터를 가져온다.
+     * endString 없이 호출하는 경우 모든 데이터를 가져온다.\n
+     * 구분자를 찾지 못한 경우 확인한 위치를 세션에 기억하여, 다음 호출에서는 새로 도착한 데이터만 확인한다.
+     * 한 바이트 또는 "\r\n" 구분자는 벡터 명령어(SSE2/AVX2)로 찾는다.
      * 
      * @param socket 클라이언트의 소켓.
      * @param buf 가져온 데이터를 저장할 buffer.
@@ -162,6 +525,65 @@ public:
      * @return false : 가져올 데이터가 없음.
      */
     bool PullFromRecvBuffer(const int32 IN socket, std::string& OUT buf, const std::string& endString = "\0");
+    /**
+     * @brief 클라이언트 세션의 recvBuffer에 있는 완성된 메세지들을 복사하지 않고 모두 가져오는 함수.
+     *
+     * 각 메세지는 recvBuffer의 메모리를 직접 가리키는 MessageView로 돌려주며, 데이터는 소비되지 않는다.\n
+     * 메세지를 다 처리한 뒤 CommitMessages()를 호출해야 recvBuffer에서 소비된다.
+     * 그 전에 같은 세션의 데이터를 받거나(RecvFromClient() 등) 가져오면 view가 가리키는 메모리가 바뀔 수 있다.\n
+     * CommitMessages() 전에 다시 호출하면 이미 돌려준 메세지도 다시 돌려주며, 메세지 budget에는 새 메세지만 센다.\n
+     * endString 없이 호출하는 경우 모든 데이터를 하나의 view로 돌려준다.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @param views 메세지들을 저장할 vector. (기존 내용은 지워진다)
+     * @param endString 구분자.
+     * @return uint64 : 가져온 메세지의 개수.
+     */
+    uint64 PeekMessages(const int32 IN socket, std::vector<struct MessageView>& OUT views, const std::string& endString = "\0");
+    /**
+     * @brief PeekMessages()로 가져온 메세지들을 recvBuffer에서 소비하는 함수.
+     *
+     * 호출 후에는 PeekMessages()가 돌려준 view를 사용해서는 안 된다.
+     * 
+     * @param socket 클라이언트의 소켓.
+     */
+    void CommitMessages(const int32 IN socket);
+    /**
+     * @brief 길이 접두 프레임 모드의 길이 필드 크기와 최대 프레임 크기를 설정하는 함수.
+     *
+     * 프레임은 big-endian 길이 필드 뒤에 그 길이만큼의 데이터가 이어지는 형식이다.
+     * (기본값은 kDefaultFrameLengthSize, kDefaultMaxFrameSize)
+     * 
+     * @param lengthSize 길이 필드의 크기. (1, 2, 4, 8 중 하나)
+     * @param maxFrameSize 허용하는 데이터의 최대 크기. (길이 필드 제외)
+     * @return true : 설정 성공.
+     * @return false : lengthSize가 올바르지 않음.
+     */
+    bool SetFrameFormat(const uint32 IN lengthSize, const uint64 IN maxFrameSize);
+    /**
+     * @brief 클라이언트 세션의 recvBuffer에서 길이 접두 프레임 하나의 데이터를 가져오는 함수.
+     *
+     * 길이 필드는 제외하고 데이터만 buf에 저장한다.\n
+     * 프레임의 길이가 최대 프레임 크기를 넘는 경우, 잘못된 상대로 보고 연결을 종료한 뒤 false를 반환한다.
+     * (연결이 종료되었는지는 GetSessionHandle()이 0을 반환하는지로 확인한다)
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @param buf 가져온 데이터를 저장할 buffer.
+     * @return true : 프레임 가져오기 성공.
+     * @return false : 완성된 프레임이 없음. (또는 잘못된 프레임으로 연결 종료됨)
+     */
+    bool PullFrameFromRecvBuffer(const int32 IN socket, std::string& OUT buf);
+    /**
+     * @brief 길이 필드를 붙여 클라이언트 세션의 sendBuffer에 프레임 하나를 추가하는 함수.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @param data 프레임의 데이터.
+     * @param size 프레임 데이터의 크기.
+     * @return true : 추가 성공.
+     * @return false : 데이터가 길이 필드로 표현할 수 없거나 최대 프레임 크기를 넘음.
+     *                 (또는 세션이 없거나 SlowConsumerDisconnect 정책으로 연결이 종료됨)
+     */
+    bool PushFrameToSendBuffer(const int32 IN socket, const char* IN data, const uint64 IN size);
     /**
      * @brief 클라이언트 세션의 연결 종료를 예약하는 함수.
      *
@@ -183,6 +605,56 @@ public:
      * @param socket 클라이언트의 소켓.
      */
     void ClearSendBuffer(const int32 IN socket);
+    /**
+     * @brief 새 연결을 더 이상 받지 않고, 남은 데이터를 보낸 뒤 모든 연결을 종료하는 drain 모드로 전환하는 함수.
+     *
+     * 서버 소켓을 닫고, 모든 세션의 연결 종료를 예약한 뒤 보낼 데이터를 한 번씩 전송한다.\n
+     * 보낼 데이터가 없는 세션은 바로 종료된다. 남은 세션은 쓰기 이벤트(또는 send 완료)에서 SendToClient()가 호출되어
+     * 데이터를 다 보내면 종료되며, IsDrained()가 true가 되면 프로그램을 종료해도 된다.\n
+     * 주로 SIGTERM 시그널 이벤트(KernelQueue::AddSignalEvent())를 받았을 때 호출한다.
+     */
+    void BeginDrain();
+    /**
+     * @brief drain 모드가 끝났는지 확인하는 함수.
+     *
+     * @return true : drain 모드이며 남은 세션이 없음.
+     * @return false : drain 모드가 아니거나 남은 세션이 있음.
+     */
+    bool IsDrained() const;
+    /**
+     * @brief drain 모드인지 확인하는 함수.
+     *
+     * @return true : drain 모드.
+     * @return false : 일반 모드.
+     */
+    bool IsDraining() const;
+    /**
+     * @brief 준비 상태 통지(KernelQueue) 대신 완료 통지(CompletionQueue)로 동작하도록 전환하는 함수.
+     *
+     * 서버 소켓에 accept 요청을 등록하며, 이후 accept와 recv는 커널이 직접 수행한다.\n
+     * 전환 후에는 ConnectNewClient(), RecvFromClient()를 사용하지 않고,
+     * queue.Poll()로 꺼낸 완료를 모두 HandleCompletion()에 전달한다.
+     * SendToClient()는 send 요청을 제출 큐에 넣고 바로 반환한다.
+     * 
+     * @param queue Init()이 완료된 CompletionQueue. (Network보다 오래 유지되어야 한다)
+     * @return true : 전환 성공.
+     * @return false : 전환 실패.
+     */
+    bool AttachCompletionQueue(CompletionQueue* IN queue);
+    /**
+     * @brief CompletionQueue에서 꺼낸 완료를 처리하는 함수.
+     *
+     * - accept : 요청에 함께 받은 주소로 세션을 추가하고 multishot recv를 등록한다.
+     * - recv : 받은 데이터를 recvBuffer에 추가하고 버퍼를 버퍼 풀에 돌려준다.
+     *   버퍼 풀이 비어 recv가 끝났다면 버퍼가 돌아올 때까지 멈추었다가 다시 등록한다.
+     * - send : 남은 데이터를 이어서 보내고, 연결 종료가 예약되어 있다면 연결을 종료한다.
+     * - 연결이 끊기거나 오류가 발생하면 연결을 종료한다.
+     * 
+     * @param completion 처리할 완료.
+     * @param socket 완료와 관련된 클라이언트의 소켓.
+     * @return eCompletionResult : 처리한 완료의 종류. (이미 종료된 세션의 완료는 CompletionNone)
+     */
+    eCompletionResult HandleCompletion(const CompletionQueue::Completion& IN completion, int32& OUT socket);
     /**
      * @brief 서버 소켓을 반환하는 함수.
      * 
@@ -191,11 +663,13 @@ public:
     int32 GetServerSocket() const;
     /**
      * @brief 특정 소켓의 IP를 문자열로 반환하는 함수.
+     *
+     * 클라이언트의 IP 문자열은 연결될 때 한 번만 만들어 세션에 저장해두므로, 호출할 때마다 할당하지 않는다.
      * 
      * @param socket 대상 소켓.
-     * @return const std::string : 대상 소켓의 IP 주소. 
+     * @return const char* : 대상 소켓의 IP 주소. (세션이 연결되어 있는 동안 유효하다)
      */
-    const std::string GetIPString(const int32 IN socket) const;
+    const char* GetIPString(const int32 IN socket) const;
     /**
      * @brief 특정 클라이언트 세션을 반환하는 함수.
      * 
@@ -203,6 +677,63 @@ public:
      * @return const struct Session& : 클라이언트의 세션.
      */
     const struct Session& GetSession(const int32 IN socket) const;
+    /**
+     * @brief 특정 클라이언트 세션의 핸들을 반환하는 함수.
+     *
+     * 세션 밖(타이머, 다른 스레드에서 Post한 작업 등)에 연결을 저장해둘 때는 소켓 대신 핸들을 저장한다.
+     * 
+     * @param socket 클라이언트 소켓.
+     * @return SessionHandle : 세션의 핸들. (세션이 없으면 0 반환)
+     */
+    SessionHandle GetSessionHandle(const int32 IN socket) const;
+    /**
+     * @brief 핸들이 가리키는 세션의 소켓을 반환하는 함수.
+     * 
+     * @param handle 세션의 핸들.
+     * @return int32 : 세션의 소켓. (연결이 종료되었거나 fd가 다른 세션에 재사용된 경우 -1 반환)
+     */
+    int32 GetSocket(const SessionHandle IN handle) const;
+    /**
+     * @brief 핸들이 가리키는 세션이 아직 연결되어 있는지 확인하는 함수.
+     * 
+     * @param handle 세션의 핸들.
+     * @return true : 연결되어 있음.
+     * @return false : 연결이 종료되었거나 fd가 다른 세션에 재사용됨.
+     */
+    bool IsValidSession(const SessionHandle IN handle) const;
+    /**
+     * @brief 연결된 세션의 개수를 반환하는 함수.
+     * 
+     * @return uint64 : 연결된 세션의 개수.
+     */
+    uint64 GetSessionCount() const;
+    /**
+     * @brief 클라이언트 세션의 버퍼들이 사용하는 메모리의 크기를 반환하는 함수.
+     *
+     * 버퍼의 메모리는 처음 사용할 때 할당되고 비면 풀에 반환되므로, 유휴 세션은 0이다.
+     * 
+     * @param socket 클라이언트의 소켓.
+     * @return uint64 : recvBuffer, sendBuffer, 전송 중인 데이터의 메모리 크기. (세션이 없다면 0)
+     */
+    uint64 GetSessionBufferMemory(const int32 IN socket) const;
+    /**
+     * @brief 모든 세션의 버퍼가 사용 중인 메모리의 크기를 반환하는 함수.
+     * 
+     * @return uint64 : 사용 중인 버퍼 메모리의 크기. (풀에 보관 중인 메모리 제외)
+     */
+    uint64 GetBufferMemory() const;
+    /**
+     * @brief 재사용을 위해 버퍼 풀에 보관 중인 메모리의 크기를 반환하는 함수.
+     * 
+     * @return uint64 : 보관 중인 메모리의 크기.
+     */
+    uint64 GetPooledBufferMemory() const;
+    /**
+     * @brief 버퍼 풀에 보관할 메모리의 최대 크기를 설정하는 함수. (기본값은 BufferPool::kDefaultLimit)
+     * 
+     * @param limit 보관할 메모리의 최대 크기. (0이면 보관하지 않고 바로 해제한다)
+     */
+    void SetBufferPoolLimit(const uint64 IN limit);
 private:
     /**
      * @brief Network 객체의 복사 생성자. (사용되지 않음)
@@ -234,15 +765,154 @@ private:
      * - non-blocking : socket을 non-blocking으로 설정.
      * - IP, port number : socket에 IP 주소와 port number 설정.
      * - reuseOption : socket 사용 후, 다시 사용하기 까지의 delay 제거.
+     * - reusePortOption : (bReusePort인 경우) 같은 port에 바인딩된 소켓들에 커널이 연결을 분배. (FreeBSD는 SO_REUSEPORT_LB)
      * - keepaliveOption : 상대방과 연결이 끊어졌는지 60초마다 확인. (TCP 연결 2시간 뒤부터 keepalive 메세지 전송 시작)
      * - nodelayOption : 작은 size의 메세지라도, 모아놓지 않고 바로 보내도록 설정. (Nagle 알고리즘 비활성화)
      * - listen : 클라이언트의 연결 요청을 받을 수 있는 상태로 설정.
      * 
      * @param port 소켓에 설정할 port number.
+     * @param bReusePort SO_REUSEPORT 설정 여부.
      * @return true : 소켓 설정 성공.
      * @return false : 소켓 설정 실패.
      */
-    bool setServerSocket(const int32 IN port);
+    bool setServerSocket(const int32 IN port, const bool IN bReusePort);
+    /**
+     * @brief 서버 소켓에서 연결 요청 하나를 수락하고 클라이언트 소켓을 non-blocking으로 설정한다.
+     *
+     * 실패한 경우 errno는 실패 원인을 나타낸다.
+     * 
+     * @param clientAddr 클라이언트의 주소를 저장할 구조체.
+     * @return int32 : 클라이언트 소켓. (실패시 -1 반환)
+     */
+    int32 acceptClient(sockaddr_in& OUT clientAddr);
+    /**
+     * @brief 데이터가 추가된 세션을 FlushSendBuffers()에서 보낼 목록에 넣는다.
+     * 
+     * @param session 대상 세션.
+     */
+    void queueFlush(struct Session& IN session);
+    /**
+     * @brief 연결된 클라이언트 소켓의 세션을 추가한다.
+     * 
+     * 세션 슬랩을 할당하지 못하면 소켓을 닫는다.
+     *
+     * @param clientSocket 클라이언트 소켓.
+     * @param clientAddr 클라이언트의 주소.
+     * @return true 성공시
+     * @return false 메모리 할당 실패시 (소켓은 닫힌다)
+     */
+    bool addSession(const int32 IN clientSocket, const sockaddr_in& IN clientAddr);
+    /**
+     * @brief 세션을 슬랩에서 제거한다. (소켓은 닫지 않는다)
+     *
+     * 버퍼의 데이터를 지우고 메모리를 풀에 돌려준다.\n
+     * send 요청이 진행 중이라면 커널이 아직 읽고 있을 수 있으므로, 전송 중인 데이터는 완료가 도착할 때까지 mOrphanSends에 보관한다.
+     *
+     * @param socket 클라이언트 소켓.
+     */
+    void removeSession(const int32 IN socket);
+    /**
+     * @brief 세션의 recvBuffer 앞에서 size 바이트를 소비하고, 구분자 탐색 위치와 PeekMessages() 상태를 초기화한다.
+     * 
+     * @param session 대상 세션.
+     * @param size 소비할 크기.
+     */
+    void consumeRecvBuffer(struct Session& IN session, const uint64 IN size);
+    /**
+     * @brief 세션의 버퍼 중 빈 버퍼의 메모리를 풀에 돌려준다. (send 요청이 진행 중인 데이터 제외)
+     * 
+     * @param session 대상 세션.
+     */
+    void releaseIdleBuffers(struct Session& IN session);
+    /**
+     * @brief 재사용 목록에서 InflightSend 객체를 꺼낸다. (목록이 비어있다면 새로 만든다)
+     * 
+     * @return struct InflightSend* : 비어있는 InflightSend 객체.
+     */
+    struct InflightSend* acquireInflightSend();
+    /**
+     * @brief InflightSend 객체의 데이터를 해제하고, 객체를 재사용 목록으로 옮긴다.
+     * 
+     * @param inflight 돌려줄 객체.
+     */
+    void releaseInflightSend(struct InflightSend* IN inflight);
+    /**
+     * @brief 세션의 보낼 데이터(sendBuffer + 전송 중인 데이터)의 크기를 반환한다.
+     * 
+     * @param session 대상 세션.
+     * @return uint64 : 보낼 데이터의 크기.
+     */
+    static uint64 getQueuedSize(const struct Session& IN session);
+    /**
+     * @brief 구분자가 바뀌었다면 세션에 기억하고 scanOffset을 0으로 초기화한다.
+     * 
+     * @param session 대상 세션.
+     * @param endString 이번에 찾을 구분자.
+     */
+    static void updateScanDelimiter(struct Session& IN OUT session, const std::string& IN endString);
+    /**
+     * @brief 완료가 도착한 mOrphanSends의 객체를 찾아 재사용 목록으로 옮긴다.
+     * 
+     * @param userData 완료된 send 요청의 사용자 정의 값.
+     */
+    void releaseOrphanSend(const uint64 IN userData);
+    /**
+     * @brief 세션의 보낼 데이터 크기를 watermark와 비교하여, 넘거나 줄어들었다면 알리고 정책대로 처리한다.
+     * 
+     * @param session 대상 세션.
+     * @return true : 세션이 유지됨.
+     * @return false : SlowConsumerDisconnect 정책으로 연결이 종료됨.
+     */
+    bool checkSendWatermark(struct Session& IN session);
+    /**
+     * @brief 세션이 이번 바퀴에 더 가져올 수 있는 메세지의 개수를 반환한다.
+     *
+     * 0이고 recvBuffer에 데이터가 남아있다면 세션을 다음 바퀴로 넘긴다.
+     * 
+     * @param session 대상 세션.
+     * @return uint64 : 남은 메세지의 개수. (제한이 없다면 uint64의 최댓값)
+     */
+    uint64 getMessageBudget(struct Session& IN session);
+    /**
+     * @brief 세션을 다음 바퀴에 이어서 처리할 목록(mCarryList)에 넣는다.
+     * 
+     * @param session 대상 세션.
+     */
+    void carrySession(struct Session& IN session);
+    /**
+     * @brief 소켓의 세션을 찾는다.
+     * 
+     * @param socket 클라이언트 소켓.
+     * @return struct Session* : 세션의 포인터. (연결된 세션이 없다면 NULL)
+     */
+    struct Session* findSession(const int32 IN socket);
+    const struct Session* findSession(const int32 IN socket) const;
+    /**
+     * @brief 완료 통지 모드에서 sendBuffer의 데이터를 InflightSend로 옮기고 send 요청을 제출 큐에 넣는다.
+     * 
+     * @param session 대상 세션.
+     * @return true : 요청 성공 (또는 보낼 데이터 없음).
+     * @return false : 연결 종료됨.
+     */
+    bool submitSend(struct Session& IN session);
+    /**
+     * @brief recv 완료가 사용한 버퍼를 돌려주고, 버퍼를 기다리던 recv 요청을 다시 등록한다.
+     *
+     * @param bufferID 돌려줄 버퍼의 번호.
+     */
+    void releaseRecvBuffer(const uint16 IN bufferID);
+    /**
+     * @brief 버퍼 풀이 비어 멈춘 recv 요청을 사용할 수 있는 버퍼의 개수만큼 다시 등록한다.
+     *
+     * 버퍼가 없는 동안 바로 다시 등록하면 같은 -ENOBUFS 완료가 반복되므로, 버퍼 하나마다 요청 하나만 등록한다.
+     */
+    void resumeRecvs();
+    /**
+     * @brief 완료 통지 모드의 요청에 붙일 사용자 정의 값을 만든다.
+     *
+     * 상위 8비트는 요청 종류, 다음 24비트는 세션의 세대, 하위 32비트는 소켓이다.
+     */
+    static uint64 makeUserData(const uint32 IN operation, const uint32 IN generation, const int32 IN socket);
 
 private:
     /**
@@ -254,11 +924,97 @@ private:
      */
     std::string mServerIPString;
     /**
-     * @brief 서버와 연결된 세션의 목록을 저장하는 멤버 변수.
+     * @brief 세션 버퍼들이 메모리를 받고 돌려주는 풀.
+     *
+     * 세션 슬랩과 InflightSend 목록보다 먼저 선언하여, 그 버퍼들이 메모리를 돌려준 뒤에 소멸되도록 한다.
+     */
+    BufferPool mBufferPool;
+    /**
+     * @brief 서버와 연결된 세션을 fd로 바로 찾을 수 있도록 저장하는 슬랩.
+     *
+     * fd의 상위 비트로 덩어리를, 하위 kSessionChunkBits 비트로 덩어리 안의 슬롯을 찾는다.\n
+     * 덩어리 단위로만 늘어나므로 세션의 주소는 바뀌지 않는다.
+     */
+    std::vector<struct Session*> mSessionChunks;
+    /**
+     * @brief 연결된 세션의 개수.
+     */
+    uint64 mSessionCount;
+    /**
+     * @brief 마지막 FlushSendBuffers() 호출 이후 sendBuffer에 데이터가 추가된 세션의 소켓 목록.
+     */
+    std::vector<int32> mFlushList;
+    /**
+     * @brief 완료 통지 모드에서 사용하는 CompletionQueue. (준비 상태 통지 모드라면 NULL)
+     */
+    CompletionQueue* mCompletionQueue;
+    /**
+     * @brief 전송 중에 연결이 종료된 세션의 InflightSend 목록.
      *
-     * key = 세션의 소켓, value = Session 구조체.
+     * 커널이 send 요청을 끝낼 때까지 메모리를 유지해야 하므로, 완료가 도착하면 mFreeInflightSends로 옮긴다.
+     * (동시에 남는 개수가 적으므로 순서대로 찾는다)
+     */
+    std::vector<struct InflightSend*> mOrphanSends;
+    /**
+     * @brief 재사용을 기다리는 InflightSend 객체 목록.
+     */
+    std::vector<struct InflightSend*> mFreeInflightSends;
+    /**
+     * @brief 완료 통지 모드의 accept 요청별 주소 슬롯. (슬롯 번호는 요청의 세대 자리에 담는다)
+     */
+    struct AcceptSlot mAcceptSlots[kAcceptSlotCount];
+    /**
+     * @brief 버퍼 풀이 비어 멈춘 recv 요청의 사용자 정의 값 목록. (멈춘 순서)
+     */
+    std::vector<uint64> mRecvWaitList;
+    /**
+     * @brief drain 모드인지 나타내는 멤버 변수.
+     */
+    bool bIsDraining;
+    /**
+     * @brief readv() 한 번을 위해 recvBuffer에 확보할 빈 공간의 최소 크기.
+     */
+    uint64 mRecvChunkSize;
+    /**
+     * @brief 한 세션에서 RecvFromClient() 한 번에 받을 수 있는 최대 크기.
+     */
+    uint64 mRecvBudget;
+    /**
+     * @brief 길이 접두 프레임의 길이 필드 크기.
+     */
+    uint32 mFrameLengthSize;
+    /**
+     * @brief 길이 접두 프레임이 허용하는 데이터의 최대 크기.
+     */
+    uint64 mMaxFrameSize;
+    /**
+     * @brief 새 세션에 적용할 보낼 데이터의 high watermark. (0이면 제한 없음)
+     */
+    uint64 mSendHighWatermark;
+    /**
+     * @brief 새 세션에 적용할 보낼 데이터의 low watermark.
+     */
+    uint64 mSendLowWatermark;
+    /**
+     * @brief 보낼 데이터가 high watermark를 넘었을 때의 정책.
+     */
+    eSlowConsumerPolicy mSlowConsumerPolicy;
+    /**
+     * @brief watermark 알림을 받을 처리기. (NULL이면 알리지 않는다)
+     */
+    SlowConsumerHandler* mSlowConsumerHandler;
+    /**
+     * @brief 한 세션에서 한 바퀴 동안 가져올 수 있는 메세지의 최대 개수. (0이면 제한 없음)
+     */
+    uint64 mMessageBudget;
+    /**
+     * @brief TakeCarriedSessions()가 호출될 때마다 증가하는 이벤트 루프 바퀴의 번호.
+     */
+    uint64 mIteration;
+    /**
+     * @brief budget을 다 써서 다음 바퀴에 이어서 처리해야 하는 세션의 소켓 목록. (넘겨진 순서)
      */
-    std::map<int32, struct Session> mSessions;
+    std::vector<int32> mCarryList;
 };
 
 }
@@ -0,0 +1,213 @@
+/**
+ * @file ReactorGroup.hpp
+ * @author Taeil-Nam (nam0314@gmail.com)
+ * @brief ReactorGroup 클래스 정의 헤더 파일.
+ * @version 0.1
+ * @date 2024-04-20
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+#pragma once
+
+#include <vector>
+#include <pthread.h>
+
+#include "../Config.hpp"
+#include <BSD-GDF/Event.hpp>
+#include <BSD-GDF/Logger.hpp>
+#include <BSD-GDF/Network/Network.hpp>
+
+namespace gdf
+{
+
+class ReactorGroup;
+
+/**
+ * @class Reactor
+ * @brief 이벤트 루프 스레드 하나가 소유하는 KernelQueue와 Network의 묶음.
+ *
+ * 각 Reactor는 SO_REUSEPORT로 같은 port에 바인딩된 자신만의 서버 소켓과 세션 목록을 가지므로,
+ * accept와 I/O가 스레드 사이를 넘나들지 않는다.\n
+ * GetKernelQueue(), GetNetwork()는 해당 Reactor의 스레드에서만 사용해야 한다.
+ * (다른 스레드에서는 GetKernelQueue().Post()로 작업을 넘긴다)
+ */
+class Reactor
+{
+public:
+    /**
+     * @brief Reactor 객체의 기본 생성자.
+     */
+    Reactor();
+    /**
+     * @brief Reactor 객체의 소멸자.
+     */
+    ~Reactor();
+
+    /**
+     * @brief Reactor가 소유한 KernelQueue를 반환하는 함수.
+     * 
+     * @return KernelQueue& : Reactor의 KernelQueue.
+     */
+    KernelQueue& GetKernelQueue();
+    /**
+     * @brief Reactor가 소유한 Network를 반환하는 함수.
+     * 
+     * @return Network& : Reactor의 Network.
+     */
+    Network& GetNetwork();
+    /**
+     * @brief ReactorGroup 안에서 Reactor의 순번을 반환하는 함수.
+     * 
+     * @return int32 : 0부터 시작하는 Reactor의 순번.
+     */
+    int32 GetIndex() const;
+
+private:
+    Reactor(const Reactor& reactor); // = delete
+    const Reactor& operator=(const Reactor& reactor); // = delete
+
+    friend class ReactorGroup;
+
+private:
+    KernelQueue mKernelQueue;
+    Network mNetwork;
+    ReactorGroup* mGroup;
+    int32 mIndex;
+    pthread_t mThread;
+    bool bIsRunning;
+};
+
+/**
+ * @class ReactorHandler
+ * @brief ReactorGroup의 이벤트 루프가 호출하는 사용자 정의 처리기 인터페이스.
+ *
+ * 하나의 처리기가 모든 Reactor 스레드에서 동시에 호출되므로,
+ * 스레드 간에 공유되는 상태는 직접 보호하거나 Reactor::GetIndex()별로 나누어 관리해야 한다.
+ */
+class ReactorHandler
+{
+public:
+    /**
+     * @brief ReactorHandler 객체의 소멸자.
+     */
+    virtual ~ReactorHandler() {}
+
+    /**
+     * @brief Reactor가 새 클라이언트를 수락한 뒤 호출되는 함수.
+     *
+     * 호출 시점에 클라이언트 소켓의 읽기 이벤트는 커널에 등록되어 있다.
+     * (등록에 실패한 소켓은 연결을 종료하며 이 함수를 호출하지 않는다)
+     * 
+     * @param reactor 클라이언트를 수락한 Reactor.
+     * @param socket 연결된 클라이언트의 소켓.
+     */
+    virtual void OnAccept(Reactor& IN reactor, const int32 IN socket);
+    /**
+     * @brief 이전 바퀴에서 수신 budget을 다 써서 넘겨진 세션을 이어서 처리할 때 호출되는 함수.
+     *
+     * Network::TakeCarriedSessions()로 꺼낸 세션마다 이벤트를 기다리기 전에 호출되며,
+     * 읽기 이벤트와 같이 RecvFromClient()와 메세지 처리를 이어서 하면 된다. (기본 구현은 아무것도 하지 않는다)
+     * 
+     * @param reactor 세션을 가진 Reactor.
+     * @param socket 넘겨진 클라이언트의 소켓.
+     */
+    virtual void OnCarriedSession(Reactor& IN reactor, const int32 IN socket);
+    /**
+     * @brief 서버 소켓 이외의 이벤트(클라이언트 소켓, 타이머)가 발생했을 때 호출되는 함수.
+     *
+     * PushToSendBuffer()로 추가한 데이터는 바퀴가 끝날 때 Network::FlushSendBuffers()로 보내지므로,
+     * SendToClient()는 send buffer가 가득 차 남은 데이터를 쓰기 이벤트에서 보낼 때만 호출하면 된다.
+     * 
+     * @param reactor 이벤트가 발생한 Reactor.
+     * @param event 발생한 이벤트.
+     */
+    virtual void OnEvent(Reactor& IN reactor, const KernelEvent& IN event) = 0;
+};
+
+/**
+ * @class ReactorGroup
+ * @brief N개의 이벤트 루프 스레드로 서버를 구동하는 multi-reactor 클래스.
+ *
+ * 스레드마다 KernelQueue, SO_REUSEPORT 서버 소켓, Network(세션 목록)를 하나씩 두고,
+ * 커널이 새 연결을 서버 소켓들에 나누어 주도록 하여 연결 수와 메세지 처리량이 코어 수에 비례하도록 한다.\n
+ * 리눅스에서는 각 스레드를 순번에 해당하는 CPU에 고정한다.
+ */
+class ReactorGroup
+{
+public:
+    /**
+     * @brief ReactorGroup 객체의 기본 생성자.
+     */
+    ReactorGroup();
+    /**
+     * @brief ReactorGroup 객체의 소멸자.
+     *
+     * 실행 중인 스레드가 있다면 Stop()을 호출하고 종료를 기다린다.
+     */
+    ~ReactorGroup();
+
+    /**
+     * @brief Reactor들을 생성하고 각자의 KernelQueue와 서버 소켓을 준비하는 함수.
+     * 
+     * @param port 모든 서버 소켓이 공유할 port number.
+     * @param handler 이벤트를 처리할 처리기. (NULL이면 실패한다, ReactorGroup보다 오래 유지되어야 한다)
+     * @param reactorCount 생성할 Reactor(스레드)의 개수. 0이면 온라인 CPU 개수를 사용한다.
+     * @return true : 모든 Reactor 준비 성공.
+     * @return false : Reactor 준비 실패.
+     */
+    bool Init(const int32 IN port, ReactorHandler* IN handler, const int32 IN reactorCount = 0);
+    /**
+     * @brief 모든 Reactor의 이벤트 루프 스레드를 시작하는 함수.
+     * 
+     * @return true : 모든 스레드 시작 성공.
+     * @return false : 스레드 시작 실패. (이미 시작된 스레드는 정지된다)
+     */
+    bool Start();
+    /**
+     * @brief 모든 이벤트 루프에 정지를 요청하는 함수. (스레드 안전)
+     */
+    void Stop();
+    /**
+     * @brief 모든 이벤트 루프 스레드가 종료될 때까지 기다리는 함수.
+     */
+    void Join();
+    /**
+     * @brief Reactor의 개수를 반환하는 함수.
+     * 
+     * @return int32 : Reactor의 개수.
+     */
+    int32 GetReactorCount() const;
+    /**
+     * @brief 특정 순번의 Reactor를 반환하는 함수.
+     * 
+     * @param index Reactor의 순번.
+     * @return Reactor& : 해당 순번의 Reactor.
+     */
+    Reactor& GetReactor(const int32 IN index);
+
+private:
+    ReactorGroup(const ReactorGroup& group); // = delete
+    const ReactorGroup& operator=(const ReactorGroup& group); // = delete
+
+    static void* runThread(void* arg);
+    void run(Reactor& reactor);
+    void release();
+
+private:
+    /**
+     * @brief Reactor 목록. (Reactor는 복사할 수 없으므로 포인터로 보관한다)
+     */
+    std::vector<Reactor*> mReactors;
+    /**
+     * @brief 이벤트를 처리할 처리기.
+     */
+    ReactorHandler* mHandler;
+    /**
+     * @brief 이벤트 루프를 정지해야 하는지 나타내는 변수. (스레드 간에 원자적으로 읽고 쓴다)
+     */
+    int32 mStopRequested;
+};
+
+}
@@ -0,0 +1,150 @@
+/**
+ * @file SendQueue.hpp
+ * @author Taeil-Nam (nam0314@gmail.com)
+ * @brief SendQueue 클래스 정의 헤더 파일.
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <sys/uio.h>
+
+#include "../Config.hpp"
+#include <BSD-GDF/Network/ByteBuffer.hpp>
+#include <BSD-GDF/Network/SharedBuffer.hpp>
+
+namespace gdf
+{
+
+/**
+ * @class SendQueue
+ * @brief 세션이 보낼 데이터를 추가된 순서대로 저장하는 큐 클래스.
+ *
+ * 복사해서 추가한 데이터는 ByteBuffer 하나에 이어 붙이고, SharedBuffer로 추가한 데이터는 복사하지 않고
+ * 참조만 저장한다.\n
+ * SharedBuffer가 한 번도 추가되지 않았다면 세그먼트 목록을 사용하지 않고 ByteBuffer만으로 동작한다.\n
+ * GetReadRegions()로 앞에서부터 iovec을 채워 sendmsg()로 한 번에 보내고, 보낸 만큼 Consume()한다.
+ */
+class SendQueue
+{
+public:
+    /**
+     * @brief SendQueue 객체의 기본 생성자.
+     */
+    SendQueue();
+    /**
+     * @brief SendQueue 객체의 소멸자.
+     */
+    ~SendQueue();
+
+    /**
+     * @brief 데이터를 복사하여 큐 뒤에 추가하는 함수.
+     *
+     * @param data 추가할 데이터.
+     * @param size 추가할 데이터의 크기.
+     */
+    void Append(const char* IN data, const uint64 IN size);
+    /**
+     * @brief 데이터를 복사하지 않고 참조만 큐 뒤에 추가하는 함수.
+     *
+     * @param buffer 추가할 데이터.
+     */
+    void Append(const SharedBuffer& IN buffer);
+    /**
+     * @brief 큐 앞에서 보낸 만큼의 데이터를 소비하는 함수.
+     *
+     * @param size 소비할 데이터의 크기.
+     */
+    void Consume(const uint64 IN size);
+    /**
+     * @brief 큐를 비우는 함수. (SharedBuffer의 참조도 놓는다)
+     */
+    void Clear();
+    /**
+     * @brief 최소 capacity 바이트를 복사해서 추가할 수 있도록 메모리를 확보하는 함수.
+     *
+     * @param capacity 확보할 크기.
+     */
+    void Reserve(const uint64 IN capacity);
+    /**
+     * @brief 다른 SendQueue와 내용을 교환하는 함수. (메모리를 복사하지 않는다)
+     *
+     * @param queue 교환할 SendQueue 객체.
+     */
+    void Swap(SendQueue& IN OUT queue);
+    /**
+     * @brief 복사해서 추가하는 데이터의 메모리를 받고 돌려줄 BufferPool을 설정하는 함수.
+     *
+     * @param pool 사용할 BufferPool. (NULL이면 new[], delete[]를 사용한다)
+     */
+    void SetPool(BufferPool* IN pool);
+    /**
+     * @brief 큐가 비어있다면 메모리를 해제(또는 풀에 반환)하는 함수.
+     */
+    void ReleaseMemory();
+    /**
+     * @brief 큐가 사용하는 메모리의 크기를 반환하는 함수. (참조만 가진 SharedBuffer의 데이터는 제외)
+     *
+     * @return uint64 : 복사된 데이터의 메모리와 세그먼트 목록의 크기.
+     */
+    uint64 GetMemoryUsage() const;
+    /**
+     * @brief 큐에 남은 데이터의 크기를 반환하는 함수.
+     *
+     * @return uint64 : 남은 데이터의 크기.
+     */
+    uint64 Size() const;
+    /**
+     * @brief 큐가 비어있는지 확인하는 함수.
+     *
+     * @return true : 비어있음.
+     * @return false : 데이터가 있음.
+     */
+    bool Empty() const;
+    /**
+     * @brief 큐 앞에서부터 데이터를 가리키는 iovec을 최대 count개까지 채우는 함수.
+     *
+     * @param regions 데이터 구간을 저장할 iovec 배열.
+     * @param count iovec 배열의 크기. (1 이상)
+     * @return uint32 : 채운 iovec의 개수. (큐가 비어있다면 0)
+     */
+    uint32 GetReadRegions(struct iovec* OUT regions, const uint32 IN count) const;
+
+private:
+    /**
+     * @brief 큐에 추가된 데이터 한 덩어리.
+     *
+     * buffer가 비어있다면 mBytes에 복사된 size 바이트를, 아니라면 buffer의 offset부터 size 바이트를 가리킨다.
+     */
+    struct Segment
+    {
+        SharedBuffer buffer;
+        uint64 offset;
+        uint64 size;
+    };
+
+private:
+    /**
+     * @brief 복사해서 추가한 데이터.
+     */
+    ByteBuffer mBytes;
+    /**
+     * @brief SharedBuffer가 추가된 뒤의 데이터 순서. (비어있다면 모든 데이터가 mBytes에 있다)
+     */
+    std::vector<Segment> mSegments;
+    /**
+     * @brief mSegments에서 아직 다 보내지 않은 첫 세그먼트의 위치.
+     */
+    uint64 mSegmentHead;
+    /**
+     * @brief 큐에 남은 데이터의 크기.
+     */
+    uint64 mSize;
+};
+
+}
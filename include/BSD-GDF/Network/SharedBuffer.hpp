@@ -0,0 +1,116 @@
+/**
+ * @file SharedBuffer.hpp
+ * @author Taeil-Nam (nam0314@gmail.com)
+ * @brief SharedBuffer 클래스 정의 헤더 파일.
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <string>
+
+#include "../Config.hpp"
+
+namespace gdf
+{
+
+/**
+ * @class SharedBuffer
+ * @brief 여러 세션이 복사 없이 함께 보내는, 변경할 수 없는 데이터를 가리키는 클래스.
+ *
+ * 데이터는 생성할 때 한 번만 복사되며, SharedBuffer 객체를 복사하면 참조 횟수만 증가한다.\n
+ * 마지막 SharedBuffer 객체가 소멸될 때 데이터가 해제된다.\n
+ * 참조 횟수는 원자적으로 변경되므로, 다른 Reactor의 세션에도 같은 데이터를 넘길 수 있다.
+ */
+class SharedBuffer
+{
+public:
+    /**
+     * @brief 빈 SharedBuffer 객체를 만드는 기본 생성자.
+     */
+    SharedBuffer();
+    /**
+     * @brief 데이터를 복사하여 SharedBuffer 객체를 만드는 생성자.
+     *
+     * @param data 복사할 데이터.
+     * @param size 복사할 데이터의 크기.
+     */
+    SharedBuffer(const char* IN data, const uint64 IN size);
+    /**
+     * @brief 문자열을 복사하여 SharedBuffer 객체를 만드는 생성자.
+     *
+     * @param data 복사할 문자열.
+     */
+    explicit SharedBuffer(const std::string& IN data);
+    /**
+     * @brief 같은 데이터를 가리키는 SharedBuffer 객체를 만드는 복사 생성자. (참조 횟수 증가)
+     *
+     * @param buffer 복사할 SharedBuffer 객체.
+     */
+    SharedBuffer(const SharedBuffer& buffer);
+    /**
+     * @brief 같은 데이터를 가리키도록 하는 복사 대입 연산자.
+     *
+     * @param buffer 복사할 SharedBuffer 객체.
+     * @return SharedBuffer& : 복사된 SharedBuffer 객체.
+     */
+    SharedBuffer& operator=(const SharedBuffer& buffer);
+    /**
+     * @brief SharedBuffer 객체의 소멸자. (참조 횟수가 0이 되면 데이터를 해제)
+     */
+    ~SharedBuffer();
+
+    /**
+     * @brief 데이터의 시작 위치를 반환하는 함수.
+     *
+     * @return const char* : 데이터의 시작 위치. (빈 SharedBuffer라면 NULL)
+     */
+    const char* GetData() const;
+    /**
+     * @brief 데이터의 크기를 반환하는 함수.
+     *
+     * @return uint64 : 데이터의 크기.
+     */
+    uint64 Size() const;
+    /**
+     * @brief 데이터가 없는지 확인하는 함수.
+     *
+     * @return true : 데이터가 없음.
+     * @return false : 데이터가 있음.
+     */
+    bool Empty() const;
+    /**
+     * @brief 같은 데이터를 가리키는 SharedBuffer 객체의 개수를 반환하는 함수.
+     *
+     * @return uint64 : 참조 횟수. (빈 SharedBuffer라면 0)
+     */
+    uint64 GetReferenceCount() const;
+
+private:
+    /**
+     * @brief 참조 횟수와 데이터를 한 번에 할당하기 위한 구조체.
+     */
+    struct Block
+    {
+        uint64 referenceCount;
+        uint64 size;
+        char data[1];
+    };
+
+    /**
+     * @brief 데이터의 참조를 하나 놓는다.
+     */
+    void release();
+
+private:
+    /**
+     * @brief 참조 횟수와 데이터가 저장된 메모리. (빈 SharedBuffer라면 NULL)
+     */
+    Block* mBlock;
+};
+
+}
@@ -0,0 +1,58 @@
+/**
+ * @file SlowConsumerHandler.hpp
+ * @author Taeil-Nam (nam0314@gmail.com)
+ * @brief SlowConsumerHandler 인터페이스 정의 헤더 파일.
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "../Config.hpp"
+
+namespace gdf
+{
+
+class Network;
+
+/**
+ * @class SlowConsumerHandler
+ * @brief 세션의 보낼 데이터가 watermark를 넘거나 다시 줄어들었을 때 알림을 받는 처리기 인터페이스.
+ *
+ * Network::SetSlowConsumerHandler()로 등록하며, 알림은 데이터를 추가하거나 보낸 함수 안에서 호출된다.\n
+ * 준비 상태 통지 모드에서 level-triggered로 읽기 이벤트를 감시하는 경우, PauseReads 정책이라면
+ * OnSendHighWatermark()에서 소켓의 읽기 이벤트를 끄고 OnSendLowWatermark()에서 다시 켜야 한다.
+ * (읽지 않는 소켓의 읽기 이벤트가 계속 발생하기 때문)
+ */
+class SlowConsumerHandler
+{
+public:
+    /**
+     * @brief SlowConsumerHandler 객체의 소멸자.
+     */
+    virtual ~SlowConsumerHandler() {}
+
+    /**
+     * @brief 세션의 보낼 데이터가 high watermark를 넘었을 때 호출되는 함수.
+     *
+     * Disconnect 정책이라면 이 함수가 반환된 뒤 연결이 종료된다.
+     *
+     * @param network 세션을 가진 Network.
+     * @param socket 클라이언트의 소켓.
+     * @param queuedSize 보낼 데이터의 크기. (sendBuffer + 전송 중인 데이터)
+     */
+    virtual void OnSendHighWatermark(Network& IN network, const int32 IN socket, const uint64 IN queuedSize) = 0;
+    /**
+     * @brief high watermark를 넘었던 세션의 보낼 데이터가 low watermark 이하로 줄어들었을 때 호출되는 함수.
+     *
+     * @param network 세션을 가진 Network.
+     * @param socket 클라이언트의 소켓.
+     * @param queuedSize 보낼 데이터의 크기. (sendBuffer + 전송 중인 데이터)
+     */
+    virtual void OnSendLowWatermark(Network& IN network, const int32 IN socket, const uint64 IN queuedSize) = 0;
+};
+
+}
@@ -56,7 +56,7 @@ void DisplayConsole::PushCharPrompt(const char IN ch)
     else if (ch == 127)
     {
         if (mPromptBuffer.size() > 0)
-            mPromptBuffer.pop_back();
+            mPromptBuffer.erase(mPromptBuffer.size() - 1);
     }
     else if (ch == '\033')
     {
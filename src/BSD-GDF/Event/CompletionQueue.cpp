@@ -0,0 +1,480 @@
+#include "BSD-GDF/Event/CompletionQueue.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(GDF_EVENT_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gdf
+{
+
+namespace
+{
+    /**
+     * 버퍼 반환 요청의 사용자 정의 값. (성공한 반환은 완료를 만들지 않으며, 실패한 반환은 Poll()이 걸러낸다)
+     */
+    const uint64 kProvideUserData = ~static_cast<uint64>(0);
+}
+
+CompletionQueue::CompletionQueue()
+: mRingFD(ERROR)
+, mSubmitRing(NULL)
+, mSubmitRingSize(0)
+, mCompleteRing(NULL)
+, mCompleteRingSize(0)
+, mSubmissions(NULL)
+, mSubmissionsSize(0)
+, mSubmitHead(NULL)
+, mSubmitTail(NULL)
+, mSubmitArray(NULL)
+, mSubmitMask(0)
+, mCompleteHead(NULL)
+, mCompleteTail(NULL)
+, mCompletions(NULL)
+, mCompleteMask(0)
+, mPendingCount(0)
+, mBuffers(NULL)
+, mBufferCount(0)
+, mBufferSize(0)
+, mLastProvide(NULL)
+, mAvailableBufferCount(0)
+, mPendingReleases()
+, mTimeout(5)
+{
+}
+
+CompletionQueue::~CompletionQueue()
+{
+    release();
+}
+
+void CompletionQueue::SetTimeout(const int64 IN ms)
+{
+    mTimeout = ms;
+}
+
+uint32 CompletionQueue::GetAvailableBufferCount() const
+{
+    return mAvailableBufferCount;
+}
+
+#if defined(GDF_EVENT_URING)
+
+bool CompletionQueue::Init(const uint32 IN entries, const uint32 IN bufferCount, const uint32 IN bufferSize)
+{
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    // 한 스레드만 제출하며, 완료 처리는 대기할 때 몰아서 하도록 하여 커널의 추가 작업을 줄인다.
+    params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+    mRingFD = static_cast<int32>(syscall(__NR_io_uring_setup, entries, &params));
+    if (mRingFD == ERROR && errno == EINVAL)
+    {
+        std::memset(&params, 0, sizeof(params));
+        mRingFD = static_cast<int32>(syscall(__NR_io_uring_setup, entries, &params));
+    }
+    if (mRingFD == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to create io_uring(errno:" << errno << " - "
+            << strerror(errno) << ") on io_uring_setup()";
+        return FAILURE;
+    }
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 || (params.features & IORING_FEAT_EXT_ARG) == 0)
+    {
+        LOG(LogLevel::Error) << "io_uring features are not supported by this kernel";
+        release();
+        return FAILURE;
+    }
+    // 제출 큐와 완료 큐는 한 번의 mmap()으로 함께 매핑된다. (IORING_FEAT_SINGLE_MMAP)
+    mSubmitRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32);
+    const uint64 completeRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (completeRingSize > mSubmitRingSize)
+    {
+        mSubmitRingSize = completeRingSize;
+    }
+    mSubmitRing = mmap(NULL, mSubmitRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       mRingFD, IORING_OFF_SQ_RING);
+    if (mSubmitRing == MAP_FAILED)
+    {
+        mSubmitRing = NULL;
+        LOG(LogLevel::Error) << "Failed to map io_uring(errno:" << errno << " - "
+            << strerror(errno) << ") on mmap()";
+        release();
+        return FAILURE;
+    }
+    mCompleteRing = mSubmitRing;
+    mSubmissionsSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    mSubmissions = mmap(NULL, mSubmissionsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        mRingFD, IORING_OFF_SQES);
+    if (mSubmissions == MAP_FAILED)
+    {
+        mSubmissions = NULL;
+        LOG(LogLevel::Error) << "Failed to map io_uring submissions(errno:" << errno << " - "
+            << strerror(errno) << ") on mmap()";
+        release();
+        return FAILURE;
+    }
+    char* submitRing = static_cast<char*>(mSubmitRing);
+    mSubmitHead = reinterpret_cast<uint32*>(submitRing + params.sq_off.head);
+    mSubmitTail = reinterpret_cast<uint32*>(submitRing + params.sq_off.tail);
+    mSubmitArray = reinterpret_cast<uint32*>(submitRing + params.sq_off.array);
+    mSubmitMask = *reinterpret_cast<uint32*>(submitRing + params.sq_off.ring_mask);
+    char* completeRing = static_cast<char*>(mCompleteRing);
+    mCompleteHead = reinterpret_cast<uint32*>(completeRing + params.cq_off.head);
+    mCompleteTail = reinterpret_cast<uint32*>(completeRing + params.cq_off.tail);
+    mCompletions = completeRing + params.cq_off.cqes;
+    mCompleteMask = *reinterpret_cast<uint32*>(completeRing + params.cq_off.ring_mask);
+    if (bufferCount == 0 || bufferCount > MAX_BUFFER_COUNT)
+    {
+        LOG(LogLevel::Error) << "Buffer count must be between 1 and " << MAX_BUFFER_COUNT << "(" << bufferCount << ")";
+        release();
+        return FAILURE;
+    }
+    mBufferCount = bufferCount;
+    mBufferSize = bufferSize;
+    mPendingReleases.reserve(bufferCount);
+    mBuffers = new (std::nothrow) char[static_cast<uint64>(bufferCount) * bufferSize];
+    if (mBuffers == NULL || provideBuffers(0, bufferCount) == FAILURE || Submit() == FAILURE)
+    {
+        LOG(LogLevel::Error) << "Failed to provide recv buffers to io_uring";
+        release();
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+bool CompletionQueue::PrepareAccept(const int32 IN socket, const uint64 IN userData,
+                                    sockaddr* OUT addr, socklen_t* OUT addrLength)
+{
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSubmission());
+    if (sqe == NULL)
+    {
+        return FAILURE;
+    }
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = socket;
+    if (addr != NULL)
+    {
+        sqe->addr = reinterpret_cast<uint64>(addr);
+        sqe->addr2 = reinterpret_cast<uint64>(addrLength);
+    }
+    else
+    {
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    }
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = userData;
+    return SUCCESS;
+}
+
+bool CompletionQueue::PrepareRecv(const int32 IN socket, const uint64 IN userData)
+{
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSubmission());
+    if (sqe == NULL)
+    {
+        return FAILURE;
+    }
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = socket;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = userData;
+    return SUCCESS;
+}
+
+bool CompletionQueue::PrepareSend(const int32 IN socket, const void* IN data, const uint32 IN length,
+                                  const uint64 IN userData)
+{
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSubmission());
+    if (sqe == NULL)
+    {
+        return FAILURE;
+    }
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = socket;
+    sqe->addr = reinterpret_cast<uint64>(data);
+    sqe->len = length;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = userData;
+    return SUCCESS;
+}
+
+bool CompletionQueue::Submit()
+{
+    if (mPendingCount == 0)
+    {
+        return SUCCESS;
+    }
+    return enter(mPendingCount, 0);
+}
+
+bool CompletionQueue::Poll(Completion& OUT completion)
+{
+    uint32 head = *mCompleteHead;
+    const uint32 tail = __atomic_load_n(mCompleteTail, __ATOMIC_ACQUIRE);
+    // 실패한 버퍼 반환 요청의 완료는 로그로 남기고 건너뛴다.
+    while (head != tail
+           && static_cast<const struct io_uring_cqe*>(mCompletions)[head & mCompleteMask].user_data == kProvideUserData)
+    {
+        const int32 result = static_cast<const struct io_uring_cqe*>(mCompletions)[head & mCompleteMask].res;
+        LOG(LogLevel::Error) << "Failed to provide recv buffer(errno:" << -result << " - "
+            << strerror(-result) << ") on io_uring";
+        ++head;
+    }
+    __atomic_store_n(mCompleteHead, head, __ATOMIC_RELEASE);
+    if (head == tail)
+    {
+        if (mPendingReleases.empty() == false)
+        {
+            retryReleases();
+        }
+        enter(mPendingCount, 1);
+        return false;
+    }
+    const struct io_uring_cqe& cqe = static_cast<const struct io_uring_cqe*>(mCompletions)[head & mCompleteMask];
+    completion.userData = cqe.user_data;
+    completion.result = cqe.res;
+    completion.bHasMore = (cqe.flags & IORING_CQE_F_MORE) != 0;
+    completion.buffer = NULL;
+    completion.bufferID = 0;
+    if (cqe.flags & IORING_CQE_F_BUFFER)
+    {
+        completion.bufferID = static_cast<uint16>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        completion.buffer = mBuffers + static_cast<uint64>(completion.bufferID) * mBufferSize;
+        --mAvailableBufferCount;
+    }
+    __atomic_store_n(mCompleteHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool CompletionQueue::ReleaseBuffer(const uint16 IN bufferID)
+{
+    if (releaseBuffer(bufferID) == FAILURE)
+    {
+        // 제출 큐에 자리가 없다면 보관했다가 다음 대기 전에 다시 반환한다.
+        mPendingReleases.push_back(bufferID);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+void* CompletionQueue::getSubmission()
+{
+    if (mRingFD == ERROR)
+    {
+        return NULL;
+    }
+    uint32 tail = *mSubmitTail;
+    if (tail - __atomic_load_n(mSubmitHead, __ATOMIC_ACQUIRE) > mSubmitMask)
+    {
+        // 제출 큐가 가득 찼다면 먼저 제출하여 자리를 만든다.
+        if (Submit() == FAILURE || tail - __atomic_load_n(mSubmitHead, __ATOMIC_ACQUIRE) > mSubmitMask)
+        {
+            LOG(LogLevel::Warning) << "io_uring submission queue is full";
+            return NULL;
+        }
+    }
+    const uint32 index = tail & mSubmitMask;
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(mSubmissions) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    mSubmitArray[index] = index;
+    __atomic_store_n(mSubmitTail, tail + 1, __ATOMIC_RELEASE);
+    ++mPendingCount;
+    return sqe;
+}
+
+bool CompletionQueue::enter(const uint32 submitCount, const uint32 waitCount)
+{
+    mLastProvide = NULL;
+    uint32 flags = 0;
+    struct __kernel_timespec waitTime;
+    struct io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    if (waitCount > 0)
+    {
+        flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        waitTime.tv_sec = mTimeout / 1000;
+        waitTime.tv_nsec = (mTimeout % 1000) * 1000 * 1000;
+        arg.ts = reinterpret_cast<uint64>(&waitTime);
+    }
+    const long result = syscall(__NR_io_uring_enter, mRingFD, submitCount, waitCount, flags,
+                                (waitCount > 0) ? &arg : NULL, sizeof(arg));
+    if (result == ERROR)
+    {
+        if (errno == ETIME || errno == EINTR || errno == EAGAIN || errno == EBUSY)
+        {
+            return SUCCESS;
+        }
+        LOG(LogLevel::Error) << "Failed to enter io_uring(errno:" << errno << " - "
+            << strerror(errno) << ") on io_uring_enter()";
+        return FAILURE;
+    }
+    mPendingCount -= static_cast<uint32>(result);
+    return SUCCESS;
+}
+
+bool CompletionQueue::provideBuffers(const uint16 bufferID, const uint32 count)
+{
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(getSubmission());
+    if (sqe == NULL)
+    {
+        return FAILURE;
+    }
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = static_cast<int32>(count);
+    sqe->addr = reinterpret_cast<uint64>(mBuffers + static_cast<uint64>(bufferID) * mBufferSize);
+    sqe->len = mBufferSize;
+    sqe->off = bufferID;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+    sqe->user_data = kProvideUserData;
+    mLastProvide = sqe;
+    mAvailableBufferCount += count;
+    return SUCCESS;
+}
+
+bool CompletionQueue::releaseBuffer(const uint16 bufferID)
+{
+    struct io_uring_sqe* last = static_cast<struct io_uring_sqe*>(mLastProvide);
+    if (last != NULL && static_cast<uint32>(last->off) + static_cast<uint32>(last->fd) == bufferID)
+    {
+        // 제출 전인 직전 반환 요청과 번호가 이어진다면 요청을 늘린다.
+        ++last->fd;
+        ++mAvailableBufferCount;
+        return SUCCESS;
+    }
+    return provideBuffers(bufferID, 1);
+}
+
+void CompletionQueue::retryReleases()
+{
+    std::size_t count = 0;
+    while (count < mPendingReleases.size() && releaseBuffer(mPendingReleases[count]) == SUCCESS)
+    {
+        ++count;
+    }
+    mPendingReleases.erase(mPendingReleases.begin(), mPendingReleases.begin() + count);
+}
+
+void CompletionQueue::release()
+{
+    if (mSubmissions != NULL)
+    {
+        munmap(mSubmissions, mSubmissionsSize);
+        mSubmissions = NULL;
+    }
+    if (mSubmitRing != NULL)
+    {
+        munmap(mSubmitRing, mSubmitRingSize);
+        mSubmitRing = NULL;
+        mCompleteRing = NULL;
+    }
+    if (mRingFD != ERROR)
+    {
+        close(mRingFD);
+        mRingFD = ERROR;
+    }
+    delete [] mBuffers;
+    mBuffers = NULL;
+    mAvailableBufferCount = 0;
+    mPendingReleases.clear();
+}
+
+#else
+
+bool CompletionQueue::Init(const uint32 IN entries, const uint32 IN bufferCount, const uint32 IN bufferSize)
+{
+    static_cast<void>(entries);
+    static_cast<void>(bufferCount);
+    static_cast<void>(bufferSize);
+    LOG(LogLevel::Error) << "io_uring is not available on this platform";
+    return FAILURE;
+}
+
+bool CompletionQueue::PrepareAccept(const int32 IN socket, const uint64 IN userData,
+                                    sockaddr* OUT addr, socklen_t* OUT addrLength)
+{
+    static_cast<void>(socket);
+    static_cast<void>(userData);
+    static_cast<void>(addr);
+    static_cast<void>(addrLength);
+    return FAILURE;
+}
+
+bool CompletionQueue::PrepareRecv(const int32 IN socket, const uint64 IN userData)
+{
+    static_cast<void>(socket);
+    static_cast<void>(userData);
+    return FAILURE;
+}
+
+bool CompletionQueue::PrepareSend(const int32 IN socket, const void* IN data, const uint32 IN length,
+                                  const uint64 IN userData)
+{
+    static_cast<void>(socket);
+    static_cast<void>(data);
+    static_cast<void>(length);
+    static_cast<void>(userData);
+    return FAILURE;
+}
+
+bool CompletionQueue::Submit()
+{
+    return FAILURE;
+}
+
+bool CompletionQueue::Poll(Completion& OUT completion)
+{
+    static_cast<void>(completion);
+    return false;
+}
+
+bool CompletionQueue::ReleaseBuffer(const uint16 IN bufferID)
+{
+    static_cast<void>(bufferID);
+    return FAILURE;
+}
+
+void* CompletionQueue::getSubmission()
+{
+    return NULL;
+}
+
+bool CompletionQueue::enter(const uint32 submitCount, const uint32 waitCount)
+{
+    static_cast<void>(submitCount);
+    static_cast<void>(waitCount);
+    return FAILURE;
+}
+
+bool CompletionQueue::provideBuffers(const uint16 bufferID, const uint32 count)
+{
+    static_cast<void>(bufferID);
+    static_cast<void>(count);
+    return FAILURE;
+}
+
+bool CompletionQueue::releaseBuffer(const uint16 bufferID)
+{
+    static_cast<void>(bufferID);
+    return FAILURE;
+}
+
+void CompletionQueue::retryReleases()
+{
+}
+
+void CompletionQueue::release()
+{
+}
+
+#endif
+
+}
@@ -67,12 +67,32 @@ bool KernelEvent::IdentifySocket(const int32 IN socket) const
 
 bool KernelEvent::IsReadType() const
 {
-    return mFilter == EVFILT_READ;
+    return mFilter == FilterRead;
 }
 
 bool KernelEvent::IsWriteType() const
 {
-    return mFilter == EVFILT_WRITE;
+    return mFilter == FilterWrite;
+}
+
+bool KernelEvent::IsTimerType() const
+{
+    return mFilter == FilterTimer;
+}
+
+bool KernelEvent::IsSignalType() const
+{
+    return mFilter == FilterSignal;
+}
+
+bool KernelEvent::IsEOF() const
+{
+    return (mFlags & FlagEOF) != 0;
+}
+
+bool KernelEvent::IsError() const
+{
+    return (mFlags & FlagError) != 0;
 }
 
 uint64 KernelEvent::GetIdentifier() const
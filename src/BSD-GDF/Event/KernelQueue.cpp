@@ -5,120 +5,389 @@
 namespace gdf
 {
 
+namespace
+{
+    uint64 getCurrentTimeNs()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64>(now.tv_sec) * 1000 * 1000 * 1000 + static_cast<uint64>(now.tv_nsec);
+    }
+
+    uint64 getCurrentTime()
+    {
+        return getCurrentTimeNs() / (1000 * 1000);
+    }
+}
+
 KernelQueue::KernelQueue()
 : mKqueue(ERROR)
 , mEventList(NULL)
+, mEventCapacity(DEFAULT_MIN_EVENT_CAPACITY)
+, mMinEventCapacity(DEFAULT_MIN_EVENT_CAPACITY)
+, mMaxEventCapacity(DEFAULT_MAX_EVENT_CAPACITY)
+, mPeakEventCount(0)
+, mShrinkCountdown(SHRINK_INTERVAL)
+, bIsSaturated(false)
 , mEventCount(0)
 , mEventIndex(0)
+, mTimeout(0)
+, mTimerEventIndex(0)
+, mLastWaitEnd(0)
+, mTaskHead(NULL)
+, mTaskTail(NULL)
+, mWakeupPending(0)
+, bIsWokenUp(false)
+#if defined(GDF_EVENT_EPOLL)
+, mWakeupFD(ERROR)
+, mSignalFD(ERROR)
+, mPendingSignals(0)
+#endif
 {
     SetTimeout(5);
+    ResetStatistics();
+#if defined(GDF_EVENT_EPOLL)
+    sigemptyset(&mSignalMask);
+#endif
 }
 
 KernelQueue::~KernelQueue()
 {
     close(mKqueue);
+#if defined(GDF_EVENT_EPOLL)
+    close(mWakeupFD);
+    if (mSignalFD != ERROR)
+    {
+        close(mSignalFD);
+    }
+#endif
     delete [] mEventList;
+    while (mTaskHead != NULL)
+    {
+        Task* next = mTaskHead->next;
+        delete mTaskHead;
+        mTaskHead = next;
+    }
 }
 
 bool KernelQueue::Init()
 {
-    mEventList = new (std::nothrow) struct kevent[MAX_KEVENT_SIZE];
-    if (mEventList == NULL)
+    if (resizeEventList(mEventCapacity) == FAILURE)
     {
         return FAILURE;
     }
-    std::memset(mEventList, 0, sizeof(struct kevent) * MAX_KEVENT_SIZE);
     if (createKqueue() == FAILURE)
     {
         return FAILURE;
     }
+    mTaskHead = new (std::nothrow) Task;
+    if (mTaskHead == NULL)
+    {
+        return FAILURE;
+    }
+    mTaskHead->next = NULL;
+    __atomic_store_n(&mTaskTail, mTaskHead, __ATOMIC_RELEASE);
+    if (createWakeup() == FAILURE)
+    {
+        return FAILURE;
+    }
     return SUCCESS;
 }
 
-bool KernelQueue::AddReadEvent(const int32 fd)
+bool KernelQueue::Poll(KernelEvent& event)
 {
-    struct kevent newEvent;
-    EV_SET(&newEvent, fd, EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, NULL);
-    if (kevent(mKqueue, &newEvent, 1, NULL, 0, NULL) == ERROR)
+    if (mEventCount == mEventIndex)
+    {
+        getEventList();
+        if (mEventCount == ERROR)
+        {
+            mEventCount = 0;
+        }
+        mEventIndex = 0;
+        return false;
+    }
+    while (mEventIndex < mEventCount)
+    {
+        if (mEventIndex >= mTimerEventIndex)
+        {
+            translateTimerEvent(event);
+            return true;
+        }
+        translateEvent(event);
+        // 처리기가 등록된 fd라면 검색 없이 udata의 처리기로 바로 전달한다.
+        KernelEventHandler* handler = static_cast<KernelEventHandler*>(const_cast<void*>(event.GetUserData()));
+        if (handler == NULL)
+        {
+            return true;
+        }
+        handler->HandleEvent(event);
+    }
+    return false;
+}
+
+KernelEventBatch KernelQueue::PollBatch()
+{
+    if (mEventCount == mEventIndex)
+    {
+        getEventList();
+        if (mEventCount == ERROR)
+        {
+            mEventCount = 0;
+        }
+        mEventIndex = 0;
+    }
+    // KernelEventEntry는 NativeEvent 하나만 가진 standard-layout 클래스이므로 배열을 그대로 재해석한다.
+    const KernelEventEntry* begin = reinterpret_cast<const KernelEventEntry*>(mEventList + mEventIndex);
+    const uint64 size = static_cast<uint64>(mEventCount - mEventIndex);
+    mEventIndex = mEventCount;
+    return KernelEventBatch(begin, size);
+}
+
+bool KernelQueue::HasPendingEvents() const
+{
+    return mEventIndex < mEventCount;
+}
+
+TimerWheel::TimerID KernelQueue::AddTimer(const uint64 delay, const uint64 interval, void* udata)
+{
+    return mTimers.Add(getCurrentTime(), delay, interval, udata);
+}
+
+bool KernelQueue::CancelTimer(const TimerWheel::TimerID id)
+{
+    return mTimers.Cancel(id);
+}
+
+bool KernelQueue::Post(TaskFunction function, void* arg)
+{
+    // Init()에서 더미 노드를 만들기 전에는 작업을 이어 붙일 곳이 없다.
+    if (__atomic_load_n(&mTaskTail, __ATOMIC_ACQUIRE) == NULL)
+    {
+        return FAILURE;
+    }
+    Task* task = new (std::nothrow) Task;
+    if (task == NULL)
     {
-        LOG(LogLevel::Error) << "Failed to add READ event(errno:" << errno << " - "
-            << strerror(errno) << ") on kevent()";
         return FAILURE;
     }
+    task->next = NULL;
+    task->function = function;
+    task->arg = arg;
+    Task* prev = __atomic_exchange_n(&mTaskTail, task, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&prev->next, task, __ATOMIC_RELEASE);
+    Wakeup();
     return SUCCESS;
 }
 
-bool KernelQueue::AddWriteEvent(const int32 fd)
+void KernelQueue::Wakeup()
+{
+    if (__atomic_exchange_n(&mWakeupPending, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        triggerWakeup();
+    }
+}
+
+void KernelQueue::GetStatistics(KernelQueueStatistics& OUT statistics) const
+{
+    statistics = mStatistics;
+}
+
+void KernelQueue::ResetStatistics()
 {
-    struct kevent newEvent;
-    EV_SET(&newEvent, fd, EVFILT_WRITE, EV_ADD | EV_ENABLE, 0, 0, NULL);
-    if (kevent(mKqueue, &newEvent, 1, NULL, 0, NULL) == ERROR)
+    std::memset(&mStatistics, 0, sizeof(mStatistics));
+    mStatistics.capacity = static_cast<uint64>(mEventCapacity);
+}
+
+bool KernelQueue::SetEventCapacity(const int32 minimum, const int32 maximum)
+{
+    if (minimum < 1 || maximum < minimum)
     {
-        LOG(LogLevel::Error) << "Failed to add WRITE event(errno:" << errno << " - "
-            << strerror(errno) << ") on kevent()";
+        LOG(LogLevel::Error) << "Invalid event capacity range(" << minimum << " ~ " << maximum << ")";
         return FAILURE;
     }
+    mMinEventCapacity = minimum;
+    mMaxEventCapacity = maximum;
     return SUCCESS;
 }
 
+int32 KernelQueue::GetEventCapacity() const
+{
+    return mEventCapacity;
+}
 
+void KernelQueue::SetTimeout(const int64 ms)
+{
+    mTimeout = ms;
+}
 
+int64 KernelQueue::GetTimeout() const
+{
+    return mTimeout;
+}
 
-bool KernelQueue::Poll(KernelEvent& event)
+const KernelQueue::NativeEvent* KernelQueue::getEventList()
 {
-    if (mEventCount == mEventIndex)
+    adjustEventCapacity();
+    mTimers.Advance(getCurrentTime());
+    // 만료된 타이머가 밀려있다면 이벤트 배열의 절반까지 타이머 이벤트 자리로 남겨두고 대기하지 않는다.
+    uint64 reserved = mTimers.GetExpiredCount();
+    if (reserved > static_cast<uint64>(mEventCapacity / 2))
     {
-        getEventList();
-        if (mEventCount == ERROR)
+        reserved = static_cast<uint64>(mEventCapacity / 2);
+    }
+    int64 timeout = mTimeout;
+    const int64 timerTimeout = mTimers.GetTimeout(getCurrentTime());
+    if (timerTimeout >= 0 && timerTimeout < timeout)
+    {
+        timeout = timerTimeout;
+    }
+    bIsWokenUp = false;
+    const int32 capacity = mEventCapacity - static_cast<int32>(reserved);
+    const uint64 waitStart = getCurrentTimeNs();
+    mEventCount = waitEvents(capacity, timeout);
+    if (mEventCount == ERROR)
+    {
+        mEventCount = 0;
+    }
+    recordWait(waitStart, getCurrentTimeNs(), capacity);
+    if (bIsWokenUp)
+    {
+        // 작업을 꺼내기 전에 내려야 이후에 들어온 작업이 다시 루프를 깨운다.
+        __atomic_store_n(&mWakeupPending, 0, __ATOMIC_RELEASE);
+    }
+    runTasks();
+    mTimerEventIndex = mEventCount;
+    appendTimerEvents();
+    return mEventList;
+}
+
+void KernelQueue::recordWait(const uint64 waitStart, const uint64 waitEnd, const int32 capacity)
+{
+    const uint64 waitTime = (waitEnd - waitStart) / 1000;
+    ++mStatistics.waitCount;
+    mStatistics.eventCount += static_cast<uint64>(mEventCount);
+    mStatistics.capacity = static_cast<uint64>(capacity);
+    bIsSaturated = (mEventCount == capacity);
+    if (bIsSaturated)
+    {
+        ++mStatistics.saturatedCount;
+    }
+    mStatistics.totalWaitTime += waitTime;
+    if (waitTime > mStatistics.maxWaitTime)
+    {
+        mStatistics.maxWaitTime = waitTime;
+    }
+    ++mStatistics.waitTimeHistogram[KernelQueueStatistics::GetHistogramIndex(waitTime)];
+    ++mStatistics.eventCountHistogram[KernelQueueStatistics::GetHistogramIndex(static_cast<uint64>(mEventCount))];
+    if (mLastWaitEnd != 0)
+    {
+        const uint64 dispatchTime = (waitStart - mLastWaitEnd) / 1000;
+        mStatistics.totalDispatchTime += dispatchTime;
+        if (dispatchTime > mStatistics.maxDispatchTime)
         {
-            mEventCount = 0;
+            mStatistics.maxDispatchTime = dispatchTime;
         }
-        mEventIndex = 0;
-        return false;
+        ++mStatistics.dispatchTimeHistogram[KernelQueueStatistics::GetHistogramIndex(dispatchTime)];
+    }
+    mLastWaitEnd = waitEnd;
+}
+
+void KernelQueue::adjustEventCapacity()
+{
+    int32 capacity = mEventCapacity;
+    if (bIsSaturated)
+    {
+        // 직전 대기가 가득 찼다면 남은 이벤트를 한 번에 받을 수 있도록 두 배로 늘린다.
+        capacity = mEventCapacity * 2;
     }
     else
     {
-        const struct kevent* current = &mEventList[mEventIndex];
-        event.SetIdent(current->ident);
-        event.SetFilter(current->filter);
-        event.SetFlags(current->flags);
-        event.SetFilterFlags(current->fflags);
-        event.SetData(current->data);
-        event.SetUserData(current->udata);
-        ++mEventIndex;
-        return true;
+        // 직전 대기에서 받은 커널 이벤트의 수는 타이머 이벤트가 시작되는 위치와 같다.
+        if (mTimerEventIndex > mPeakEventCount)
+        {
+            mPeakEventCount = mTimerEventIndex;
+        }
+        if (--mShrinkCountdown <= 0)
+        {
+            if (mPeakEventCount <= mEventCapacity / 4)
+            {
+                capacity = mEventCapacity / 2;
+            }
+            mPeakEventCount = 0;
+            mShrinkCountdown = SHRINK_INTERVAL;
+        }
+    }
+    if (capacity > mMaxEventCapacity)
+    {
+        capacity = mMaxEventCapacity;
+    }
+    if (capacity < mMinEventCapacity)
+    {
+        capacity = mMinEventCapacity;
+    }
+    if (capacity != mEventCapacity)
+    {
+        resizeEventList(capacity);
     }
 }
 
-bool KernelQueue::createKqueue()
+bool KernelQueue::resizeEventList(const int32 capacity)
 {
-    mKqueue = kqueue();
-    if (mKqueue == ERROR)
+    NativeEvent* eventList = new (std::nothrow) NativeEvent[capacity];
+    if (eventList == NULL)
     {
-        LOG(LogLevel::Error) << "Faild to excute Kqueue (errno:" << errno << " - "
-            << strerror(errno) << ") on kqueue()";
+        LOG(LogLevel::Error) << "Failed to allocate event list(capacity:" << capacity << ")";
         return FAILURE;
     }
+    std::memset(eventList, 0, sizeof(NativeEvent) * capacity);
+    delete [] mEventList;
+    mEventList = eventList;
+    mEventCapacity = capacity;
+    mPeakEventCount = 0;
+    mShrinkCountdown = SHRINK_INTERVAL;
     return SUCCESS;
 }
 
-const struct kevent* KernelQueue::getEventList()
+void KernelQueue::runTasks()
 {
-    mEventCount = kevent(mKqueue, NULL, 0,
-                         mEventList, MAX_KEVENT_SIZE, &mTimeout);
-    if (mEventCount == ERROR)
+    Task* next = __atomic_load_n(&mTaskHead->next, __ATOMIC_ACQUIRE);
+    while (next != NULL)
     {
-        LOG(LogLevel::Error) << "Failed to generate Event list (errno:" << errno << " - "
-            << strerror(errno) << ") on kevent()";
-        return NULL;
+        Task* head = mTaskHead;
+        mTaskHead = next;
+        delete head;
+        next->function(next->arg);
+        next = __atomic_load_n(&mTaskHead->next, __ATOMIC_ACQUIRE);
     }
-    return mEventList;
 }
 
-void KernelQueue::SetTimeout(const int64 ms)
+void KernelQueue::translateTimerEvent(KernelEvent& event)
+{
+    const ExpiredTimer& timer = mExpiredTimers[mEventIndex - mTimerEventIndex];
+    event.SetIdent(timer.id);
+    event.SetFilter(KernelEvent::FilterTimer);
+    event.SetFlags(0);
+    event.SetFilterFlags(0);
+    event.SetData(1);
+    event.SetUserData(timer.udata);
+    ++mEventIndex;
+}
+
+void KernelQueue::appendTimerEvents()
 {
-    mTimeout.tv_sec = ms / 1000;
-    mTimeout.tv_nsec = (ms % 1000) * 1000 * 1000;
+    mExpiredTimers.clear();
+    if (mTimers.GetCount() == 0 && mTimers.GetExpiredCount() == 0)
+    {
+        return;
+    }
+    mTimers.Advance(getCurrentTime());
+    ExpiredTimer timer;
+    while (mEventCount < mEventCapacity && mTimers.PopExpired(timer.id, timer.udata))
+    {
+        fillTimerEvent(mEventList[mEventCount], timer.id, timer.udata);
+        mExpiredTimers.push_back(timer);
+        ++mEventCount;
+    }
 }
 
 }
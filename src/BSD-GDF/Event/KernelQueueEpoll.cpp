@@ -0,0 +1,466 @@
+#include "BSD-GDF/Event/KernelQueue.hpp"
+
+#include "BSD-GDF/Event/KernelEvent.hpp"
+
+#if defined(GDF_EVENT_EPOLL)
+
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+
+namespace gdf
+{
+
+namespace
+{
+    const uint32 kReadEvents = EPOLLIN | EPOLLRDHUP | EPOLLPRI;
+}
+
+bool KernelQueue::AddReadEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeInterest(fd, EPOLLIN, InterestAdd, mode, handler);
+}
+
+bool KernelQueue::AddWriteEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeInterest(fd, EPOLLOUT, InterestAdd, mode, handler);
+}
+
+bool KernelQueue::ModifyReadEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeInterest(fd, EPOLLIN, InterestModify, mode, handler);
+}
+
+bool KernelQueue::ModifyWriteEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeInterest(fd, EPOLLOUT, InterestModify, mode, handler);
+}
+
+bool KernelQueue::DeleteReadEvent(const int32 fd)
+{
+    return changeInterest(fd, EPOLLIN, InterestDelete, ModeLevel, NULL);
+}
+
+bool KernelQueue::DeleteWriteEvent(const int32 fd)
+{
+    return changeInterest(fd, EPOLLOUT, InterestDelete, ModeLevel, NULL);
+}
+
+bool KernelQueue::EnableReadEvent(const int32 fd)
+{
+    return changeInterest(fd, EPOLLIN, InterestEnable, ModeLevel, NULL);
+}
+
+bool KernelQueue::DisableReadEvent(const int32 fd)
+{
+    return changeInterest(fd, EPOLLIN, InterestDisable, ModeLevel, NULL);
+}
+
+bool KernelQueue::EnableWriteEvent(const int32 fd)
+{
+    return changeInterest(fd, EPOLLOUT, InterestEnable, ModeLevel, NULL);
+}
+
+bool KernelQueue::DisableWriteEvent(const int32 fd)
+{
+    return changeInterest(fd, EPOLLOUT, InterestDisable, ModeLevel, NULL);
+}
+
+bool KernelQueue::AddSignalEvent(const int32 signal)
+{
+    if (signal <= 0 || signal > SIGRTMAX)
+    {
+        LOG(LogLevel::Error) << "Invalid signal number(" << signal << ")";
+        return FAILURE;
+    }
+    sigset_t mask = mSignalMask;
+    sigaddset(&mask, signal);
+    // signalfd는 막혀있는(blocked) 시그널만 읽을 수 있다.
+    sigset_t blocked;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, signal);
+    if (pthread_sigmask(SIG_BLOCK, &blocked, NULL) != 0)
+    {
+        LOG(LogLevel::Error) << "Failed to block signal(" << signal << ") on pthread_sigmask()";
+        return FAILURE;
+    }
+    const int32 signalFD = signalfd(mSignalFD, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signalFD == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to create signal fd(errno:" << errno << " - "
+            << strerror(errno) << ") on signalfd()";
+        return FAILURE;
+    }
+    if (mSignalFD == ERROR)
+    {
+        struct epoll_event newEvent;
+        std::memset(&newEvent, 0, sizeof(newEvent));
+        newEvent.events = EPOLLIN;
+        newEvent.data.fd = signalFD;
+        if (epoll_ctl(mKqueue, EPOLL_CTL_ADD, signalFD, &newEvent) == ERROR)
+        {
+            LOG(LogLevel::Error) << "Failed to add signal event(errno:" << errno << " - "
+                << strerror(errno) << ") on epoll_ctl()";
+            close(signalFD);
+            return FAILURE;
+        }
+        mSignalFD = signalFD;
+    }
+    mSignalMask = mask;
+    return SUCCESS;
+}
+
+bool KernelQueue::DeleteSignalEvent(const int32 signal)
+{
+    if (mSignalFD == ERROR || sigismember(&mSignalMask, signal) != 1)
+    {
+        return FAILURE;
+    }
+    sigdelset(&mSignalMask, signal);
+    if (signalfd(mSignalFD, &mSignalMask, SFD_NONBLOCK | SFD_CLOEXEC) == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to update signal fd(errno:" << errno << " - "
+            << strerror(errno) << ") on signalfd()";
+        return FAILURE;
+    }
+    mPendingSignals &= ~(static_cast<uint64>(1) << (signal - 1));
+    sigset_t unblocked;
+    sigemptyset(&unblocked);
+    sigaddset(&unblocked, signal);
+    pthread_sigmask(SIG_UNBLOCK, &unblocked, NULL);
+    return SUCCESS;
+}
+
+bool KernelQueue::Flush()
+{
+    bool result = SUCCESS;
+    for (std::size_t i = 0; i < mChangeList.size(); ++i)
+    {
+        if (applyInterest(mChangeList[i]) == FAILURE)
+        {
+            LOG(LogLevel::Error) << "Failed to register event(fd:" << mChangeList[i] << ", errno:"
+                << errno << " - " << strerror(errno) << ") on epoll_ctl()";
+            result = FAILURE;
+        }
+    }
+    mChangeList.clear();
+    return result;
+}
+
+bool KernelQueue::createKqueue()
+{
+    mKqueue = epoll_create1(EPOLL_CLOEXEC);
+    if (mKqueue == ERROR)
+    {
+        LOG(LogLevel::Error) << "Faild to excute epoll (errno:" << errno << " - "
+            << strerror(errno) << ") on epoll_create1()";
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int32 KernelQueue::waitEvents(const int32 capacity, const int64 timeout)
+{
+    Flush();
+    // 전달하지 못한 시그널이 남아있다면 대기하지 않는다.
+    int32 eventCount = epoll_wait(mKqueue, mEventList, capacity,
+                                  (mPendingSignals != 0) ? 0 : static_cast<int32>(timeout));
+    if (eventCount == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to generate Event list (errno:" << errno << " - "
+            << strerror(errno) << ") on epoll_wait()";
+        return ERROR;
+    }
+    // 깨우기 이벤트는 소비하고 이벤트 목록에서 제외한다.
+    for (int32 i = 0; i < eventCount; ++i)
+    {
+        if (mEventList[i].data.fd == mWakeupFD)
+        {
+            uint64 value;
+            if (read(mWakeupFD, &value, sizeof(value)) == ERROR && errno != EAGAIN)
+            {
+                LOG(LogLevel::Error) << "Failed to consume wakeup event(errno:" << errno << " - "
+                    << strerror(errno) << ") on read()";
+            }
+            bIsWokenUp = true;
+            mEventList[i--] = mEventList[--eventCount];
+        }
+        else if (mEventList[i].data.fd == mSignalFD && mSignalFD != ERROR)
+        {
+            readSignals();
+            mEventList[i--] = mEventList[--eventCount];
+        }
+    }
+    return appendSignalEvents(eventCount, capacity);
+}
+
+void KernelQueue::translateEvent(KernelEvent& event)
+{
+    // epoll은 읽기/쓰기 준비를 한 항목으로 보고하므로, kqueue와 같이 필터당 하나의 이벤트로 나누어 전달한다.
+    struct epoll_event* current = &mEventList[mEventIndex];
+    if (current->events & KernelEventEntry::EpollSignalEvent)
+    {
+        event.SetIdent(current->data.u64);
+        event.SetFilter(KernelEvent::FilterSignal);
+        event.SetFlags(0);
+        event.SetFilterFlags(0);
+        event.SetData(1);
+        event.SetUserData(NULL);
+        ++mEventIndex;
+        return;
+    }
+    const int32 fd = current->data.fd;
+    uint16 flags = 0;
+    if (current->events & (EPOLLHUP | EPOLLRDHUP))
+    {
+        flags |= KernelEvent::FlagEOF;
+    }
+    if (current->events & EPOLLERR)
+    {
+        flags |= KernelEvent::FlagError;
+    }
+    event.SetIdent(static_cast<uint64>(fd));
+    event.SetFlags(flags);
+    event.SetFilterFlags(0);
+    event.SetData(0);
+    const bool hasInterest = static_cast<uint64>(fd) < mInterests.size();
+
+    const bool isReadable = (current->events & kReadEvents) != 0;
+    const bool isWritable = (current->events & EPOLLOUT) != 0;
+    const bool isReadInterest = hasInterest && (mInterests[fd].events & EPOLLIN);
+    if (isReadable || (!isWritable && isReadInterest))
+    {
+        event.SetFilter(KernelEvent::FilterRead);
+        event.SetUserData(hasInterest ? mInterests[fd].readHandler : NULL);
+        current->events &= ~kReadEvents;
+        if (isWritable == false)
+        {
+            ++mEventIndex;
+        }
+    }
+    else
+    {
+        event.SetFilter(KernelEvent::FilterWrite);
+        event.SetUserData(hasInterest ? mInterests[fd].writeHandler : NULL);
+        ++mEventIndex;
+    }
+}
+
+bool KernelQueue::createWakeup()
+{
+    mWakeupFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (mWakeupFD == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to create wakeup fd(errno:" << errno << " - "
+            << strerror(errno) << ") on eventfd()";
+        return FAILURE;
+    }
+    struct epoll_event newEvent;
+    std::memset(&newEvent, 0, sizeof(newEvent));
+    newEvent.events = EPOLLIN;
+    newEvent.data.fd = mWakeupFD;
+    if (epoll_ctl(mKqueue, EPOLL_CTL_ADD, mWakeupFD, &newEvent) == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to add wakeup event(errno:" << errno << " - "
+            << strerror(errno) << ") on epoll_ctl()";
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+void KernelQueue::triggerWakeup()
+{
+    const uint64 value = 1;
+    if (write(mWakeupFD, &value, sizeof(value)) == ERROR && errno != EAGAIN)
+    {
+        LOG(LogLevel::Error) << "Failed to trigger wakeup event(errno:" << errno << " - "
+            << strerror(errno) << ") on write()";
+    }
+}
+
+void KernelQueue::fillTimerEvent(struct epoll_event& native, const TimerWheel::TimerID id, void* udata)
+{
+    static_cast<void>(udata);
+    native.events = KernelEventEntry::EpollTimerEvent;
+    native.data.u64 = id;
+}
+
+void KernelQueue::readSignals()
+{
+    struct signalfd_siginfo infos[16];
+    ssize_t readLength;
+    while ((readLength = read(mSignalFD, infos, sizeof(infos))) > 0)
+    {
+        const int32 count = static_cast<int32>(readLength / sizeof(infos[0]));
+        for (int32 i = 0; i < count; ++i)
+        {
+            if (infos[i].ssi_signo > 0 && infos[i].ssi_signo <= 64)
+            {
+                mPendingSignals |= static_cast<uint64>(1) << (infos[i].ssi_signo - 1);
+            }
+        }
+    }
+}
+
+int32 KernelQueue::appendSignalEvents(const int32 eventCount, const int32 capacity)
+{
+    // 같은 시그널이 여러 번 도착했더라도 한 번의 대기에서는 하나의 이벤트로 전달한다.
+    int32 count = eventCount;
+    while (mPendingSignals != 0 && count < capacity)
+    {
+        const int32 signal = __builtin_ctzll(mPendingSignals) + 1;
+        mPendingSignals &= mPendingSignals - 1;
+        mEventList[count].events = KernelEventEntry::EpollSignalEvent;
+        mEventList[count].data.u64 = static_cast<uint64>(signal);
+        ++count;
+    }
+    return count;
+}
+
+bool KernelQueue::changeInterest(const int32 fd, const uint32 interest,
+                                 const eInterestOp op, const int32 mode, KernelEventHandler* handler)
+{
+    if (fd < 0)
+    {
+        LOG(LogLevel::Error) << "Failed to change event(fd:" << fd << ") on epoll_ctl()";
+        return FAILURE;
+    }
+    if (static_cast<uint64>(fd) >= mInterests.size())
+    {
+        mInterests.resize(fd + 1, Interest());
+    }
+    Interest& current = mInterests[fd];
+    switch (op)
+    {
+    case InterestAdd:
+    case InterestModify:
+    {
+        uint32 flags = 0;
+        if (mode & ModeEdge)
+        {
+            flags |= EPOLLET;
+        }
+        if (mode & ModeOneShot)
+        {
+            flags |= EPOLLONESHOT;
+        }
+        // epoll은 모드를 fd 단위로 적용하므로, 다른 방향이 다른 모드로 등록되어 있다면 거부한다.
+        if (((current.events | current.disabled) & ~interest) != 0 && flags != current.flags)
+        {
+            LOG(LogLevel::Error) << "Failed to change event(fd:" << fd << ", mixed mode) on epoll_ctl()";
+            return FAILURE;
+        }
+        current.events |= interest;
+        current.disabled &= ~interest;
+        current.flags = flags;
+        current.added |= interest;
+        setHandler(current, interest, handler);
+        break;
+    }
+    case InterestDelete:
+        current.events &= ~interest;
+        current.disabled &= ~interest;
+        setHandler(current, interest, NULL);
+        if ((current.events | current.disabled) == 0)
+        {
+            current.flags = 0;
+        }
+        break;
+    case InterestEnable:
+        if (current.disabled & interest)
+        {
+            current.events |= interest;
+            current.disabled &= ~interest;
+        }
+        current.added |= (current.events & interest);
+        break;
+    case InterestDisable:
+        if (current.events & interest)
+        {
+            current.events &= ~interest;
+            current.disabled |= interest;
+        }
+        break;
+    }
+    if (current.isChanged == false)
+    {
+        current.isChanged = true;
+        mChangeList.push_back(fd);
+    }
+    return SUCCESS;
+}
+
+void KernelQueue::setHandler(Interest& current, const uint32 interest, KernelEventHandler* handler)
+{
+    if (interest & EPOLLIN)
+    {
+        current.readHandler = handler;
+    }
+    if (interest & EPOLLOUT)
+    {
+        current.writeHandler = handler;
+    }
+}
+
+bool KernelQueue::applyInterest(const int32 fd)
+{
+    Interest& current = mInterests[fd];
+    const uint32 added = current.added;
+    current.isChanged = false;
+    current.added = 0;
+    uint32 desired = (current.events != 0) ? (current.events | current.flags) : 0;
+    if (desired == current.registered && added == 0)
+    {
+        return SUCCESS;
+    }
+    struct epoll_event newEvent;
+    std::memset(&newEvent, 0, sizeof(newEvent));
+    newEvent.events = (desired & EPOLLIN) ? (desired | EPOLLRDHUP) : desired;
+    newEvent.data.fd = fd;
+    int32 result = SUCCESS;
+    if (desired == 0)
+    {
+        result = epoll_ctl(mKqueue, EPOLL_CTL_DEL, fd, &newEvent);
+        // 이미 close()되어 자동으로 제거된 fd라면 제거된 것으로 본다.
+        if (result == ERROR && (errno == ENOENT || errno == EBADF))
+        {
+            result = SUCCESS;
+        }
+    }
+    else if (current.registered == 0)
+    {
+        result = epoll_ctl(mKqueue, EPOLL_CTL_ADD, fd, &newEvent);
+        if (result == ERROR && errno == EEXIST)
+        {
+            result = epoll_ctl(mKqueue, EPOLL_CTL_MOD, fd, &newEvent);
+        }
+    }
+    else
+    {
+        result = epoll_ctl(mKqueue, EPOLL_CTL_MOD, fd, &newEvent);
+        if (result == ERROR && errno == ENOENT && (current.events & added) != 0)
+        {
+            // close()된 fd는 epoll에서 자동으로 제거되므로, 재사용된 fd에는 이번에 추가된 관심 이벤트와 처리기만 남긴다.
+            Interest reused = Interest();
+            reused.events = current.events & added;
+            reused.flags = current.flags;
+            setHandler(reused, EPOLLIN, (reused.events & EPOLLIN) ? current.readHandler : NULL);
+            setHandler(reused, EPOLLOUT, (reused.events & EPOLLOUT) ? current.writeHandler : NULL);
+            current = reused;
+            desired = current.events | current.flags;
+            newEvent.events = (desired & EPOLLIN) ? (desired | EPOLLRDHUP) : desired;
+            result = epoll_ctl(mKqueue, EPOLL_CTL_ADD, fd, &newEvent);
+        }
+    }
+    if (result == ERROR)
+    {
+        current = Interest();
+        return FAILURE;
+    }
+    current.registered = desired;
+    return SUCCESS;
+}
+
+}
+
+#endif
@@ -0,0 +1,269 @@
+#include "BSD-GDF/Event/KernelQueue.hpp"
+
+#include "BSD-GDF/Event/KernelEvent.hpp"
+
+#if defined(GDF_EVENT_KQUEUE)
+
+namespace gdf
+{
+
+namespace
+{
+    const uintptr_t kWakeupIdent = 0;
+}
+
+bool KernelQueue::AddReadEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeEvent(fd, EVFILT_READ, EV_ADD | EV_ENABLE, mode, handler);
+}
+
+bool KernelQueue::AddWriteEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeEvent(fd, EVFILT_WRITE, EV_ADD | EV_ENABLE, mode, handler);
+}
+
+bool KernelQueue::ModifyReadEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeEvent(fd, EVFILT_READ, EV_ADD | EV_ENABLE, mode, handler);
+}
+
+bool KernelQueue::ModifyWriteEvent(const int32 fd, const int32 mode, KernelEventHandler* handler)
+{
+    return changeEvent(fd, EVFILT_WRITE, EV_ADD | EV_ENABLE, mode, handler);
+}
+
+bool KernelQueue::DeleteReadEvent(const int32 fd)
+{
+    return changeEvent(fd, EVFILT_READ, EV_DELETE, ModeLevel, NULL);
+}
+
+bool KernelQueue::DeleteWriteEvent(const int32 fd)
+{
+    return changeEvent(fd, EVFILT_WRITE, EV_DELETE, ModeLevel, NULL);
+}
+
+bool KernelQueue::EnableReadEvent(const int32 fd)
+{
+    return changeEvent(fd, EVFILT_READ, EV_ENABLE, ModeLevel, NULL);
+}
+
+bool KernelQueue::DisableReadEvent(const int32 fd)
+{
+    return changeEvent(fd, EVFILT_READ, EV_DISABLE, ModeLevel, NULL);
+}
+
+bool KernelQueue::EnableWriteEvent(const int32 fd)
+{
+    return changeEvent(fd, EVFILT_WRITE, EV_ENABLE, ModeLevel, NULL);
+}
+
+bool KernelQueue::DisableWriteEvent(const int32 fd)
+{
+    return changeEvent(fd, EVFILT_WRITE, EV_DISABLE, ModeLevel, NULL);
+}
+
+bool KernelQueue::AddSignalEvent(const int32 signal)
+{
+    // kqueue는 시그널이 처리된 뒤에도 이벤트를 보고하므로, 기본 동작(프로세스 종료)을 막는다.
+    if (std::signal(signal, SIG_IGN) == SIG_ERR)
+    {
+        LOG(LogLevel::Error) << "Failed to ignore signal(" << signal << ", errno:" << errno << " - "
+            << strerror(errno) << ") on signal()";
+        return FAILURE;
+    }
+    struct kevent newEvent;
+    EV_SET(&newEvent, signal, EVFILT_SIGNAL, EV_ADD | EV_ENABLE, 0, 0, NULL);
+    queueChange(newEvent);
+    return SUCCESS;
+}
+
+bool KernelQueue::DeleteSignalEvent(const int32 signal)
+{
+    struct kevent newEvent;
+    EV_SET(&newEvent, signal, EVFILT_SIGNAL, EV_DELETE, 0, 0, NULL);
+    queueChange(newEvent);
+    const bool result = Flush();
+    std::signal(signal, SIG_DFL);
+    return result;
+}
+
+bool KernelQueue::Flush()
+{
+    if (mChangeList.empty())
+    {
+        return SUCCESS;
+    }
+    const int32 changeCount = static_cast<int32>(mChangeList.size());
+    for (int32 i = 0; i < changeCount; ++i)
+    {
+        mChangeList[i].flags |= EV_RECEIPT;
+    }
+    mReceiptList.resize(mChangeList.size());
+    const struct timespec noWait = { 0, 0 };
+    const int32 receiptCount = kevent(mKqueue, &mChangeList[0], changeCount,
+                                      &mReceiptList[0], changeCount, &noWait);
+    mChangeList.clear();
+    if (receiptCount == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to flush change list(errno:" << errno << " - "
+            << strerror(errno) << ") on kevent()";
+        return FAILURE;
+    }
+    bool result = SUCCESS;
+    for (int32 i = 0; i < receiptCount; ++i)
+    {
+        if ((mReceiptList[i].flags & EV_ERROR) && mReceiptList[i].data != 0)
+        {
+            LOG(LogLevel::Error) << "Failed to register event(fd:" << mReceiptList[i].ident
+                << ", filter:" << mReceiptList[i].filter << ", errno:" << mReceiptList[i].data
+                << " - " << strerror(static_cast<int32>(mReceiptList[i].data)) << ") on kevent()";
+            result = FAILURE;
+        }
+    }
+    return result;
+}
+
+bool KernelQueue::createKqueue()
+{
+    mKqueue = kqueue();
+    if (mKqueue == ERROR)
+    {
+        LOG(LogLevel::Error) << "Faild to excute Kqueue (errno:" << errno << " - "
+            << strerror(errno) << ") on kqueue()";
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int32 KernelQueue::waitEvents(const int32 capacity, const int64 timeout)
+{
+    // 대기와 함께 제출된 변경 항목은 실패한 경우에만 EV_ERROR 항목으로 이벤트 목록에 돌아온다.
+    // (EV_RECEIPT를 붙이면 커널이 대기하지 않고 영수증만 반환하므로 여기서는 사용하지 않는다.)
+    // 만료된 타이머 자리를 남겨두어 이번 대기의 크기가 변경 목록보다 작다면, 실패 항목이 잘리지 않도록 먼저 따로 제출한다.
+    if (mChangeList.size() > static_cast<uint64>(capacity))
+    {
+        Flush();
+    }
+    const int32 changeCount = static_cast<int32>(mChangeList.size());
+    struct timespec waitTime;
+    waitTime.tv_sec = timeout / 1000;
+    waitTime.tv_nsec = (timeout % 1000) * 1000 * 1000;
+    int32 eventCount = kevent(mKqueue, changeCount > 0 ? &mChangeList[0] : NULL, changeCount,
+                              mEventList, capacity, &waitTime);
+    mChangeList.clear();
+    if (eventCount == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to generate Event list (errno:" << errno << " - "
+            << strerror(errno) << ") on kevent()";
+        return ERROR;
+    }
+    // 깨우기 이벤트와 등록 실패 항목(로그로 남긴다)은 이벤트 목록에서 제외한다.
+    const int32 receivedCount = eventCount;
+    eventCount = 0;
+    for (int32 i = 0; i < receivedCount; ++i)
+    {
+        if (mEventList[i].filter == EVFILT_USER && mEventList[i].ident == kWakeupIdent)
+        {
+            bIsWokenUp = true;
+            continue;
+        }
+        if ((mEventList[i].flags & EV_ERROR) && mEventList[i].data != 0)
+        {
+            LOG(LogLevel::Warning) << "Failed to register event(fd:" << mEventList[i].ident
+                << ", filter:" << mEventList[i].filter << ", errno:" << mEventList[i].data
+                << " - " << strerror(static_cast<int32>(mEventList[i].data)) << ") on kevent()";
+            continue;
+        }
+        mEventList[eventCount++] = mEventList[i];
+    }
+    return eventCount;
+}
+
+void KernelQueue::translateEvent(KernelEvent& event)
+{
+    const struct kevent* current = &mEventList[mEventIndex];
+    event.SetIdent(current->ident);
+    event.SetFilter(current->filter);
+    event.SetFlags(current->flags);
+    event.SetFilterFlags(current->fflags);
+    event.SetData(current->data);
+    event.SetUserData(current->udata);
+    ++mEventIndex;
+}
+
+bool KernelQueue::changeEvent(const int32 fd, const int16 filter, const uint16 flags, const int32 mode,
+                              KernelEventHandler* handler)
+{
+    uint16 modeFlags = 0;
+    if (mode & ModeEdge)
+    {
+        modeFlags |= EV_CLEAR;
+    }
+    if (mode & ModeOneShot)
+    {
+        modeFlags |= EV_ONESHOT;
+    }
+    if (flags & EV_DELETE)
+    {
+        // 아직 제출되지 않은 같은 fd, 필터의 변경은 의미가 없으므로 버린다.
+        std::vector<struct kevent>::iterator it = mChangeList.begin();
+        while (it != mChangeList.end())
+        {
+            if (it->ident == static_cast<uintptr_t>(fd) && it->filter == filter)
+            {
+                it = mChangeList.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    struct kevent newEvent;
+    EV_SET(&newEvent, fd, filter, flags | modeFlags, 0, 0, handler);
+    queueChange(newEvent);
+    return SUCCESS;
+}
+
+bool KernelQueue::createWakeup()
+{
+    struct kevent newEvent;
+    EV_SET(&newEvent, kWakeupIdent, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, NULL);
+    if (kevent(mKqueue, &newEvent, 1, NULL, 0, NULL) == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to add USER event(errno:" << errno << " - "
+            << strerror(errno) << ") on kevent()";
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+void KernelQueue::triggerWakeup()
+{
+    struct kevent trigger;
+    EV_SET(&trigger, kWakeupIdent, EVFILT_USER, 0, NOTE_TRIGGER, 0, NULL);
+    if (kevent(mKqueue, &trigger, 1, NULL, 0, NULL) == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to trigger USER event(errno:" << errno << " - "
+            << strerror(errno) << ") on kevent()";
+    }
+}
+
+void KernelQueue::fillTimerEvent(struct kevent& native, const TimerWheel::TimerID id, void* udata)
+{
+    EV_SET(&native, id, EVFILT_TIMER, 0, 0, 1, udata);
+}
+
+void KernelQueue::queueChange(const struct kevent& change)
+{
+    // 변경 목록은 이벤트 배열의 최소 크기를 넘지 않게 유지한다. (대기 크기가 더 작다면 waitEvents()에서 먼저 제출한다)
+    if (mChangeList.size() >= static_cast<uint64>(mMinEventCapacity))
+    {
+        Flush();
+    }
+    mChangeList.push_back(change);
+}
+
+}
+
+#endif
@@ -0,0 +1,353 @@
+#include "BSD-GDF/Event/TimerWheel.hpp"
+
+namespace gdf
+{
+
+namespace
+{
+    const uint64 kMaxDelta = (static_cast<uint64>(1) << 32) - 1;
+}
+
+TimerWheel::TimerWheel()
+: mFreeHead(NIL)
+, mCurrentTick(0)
+, mCount(0)
+, mExpiredIndex(0)
+{
+    for (int32 i = 0; i < SLOT_COUNT; ++i)
+    {
+        mHeads[i] = NIL;
+    }
+    for (int32 i = 0; i < BITMAP_COUNT; ++i)
+    {
+        mBitmaps[i] = 0;
+    }
+}
+
+TimerWheel::~TimerWheel()
+{
+}
+
+TimerWheel::TimerID TimerWheel::Add(const uint64 IN now, const uint64 IN delay,
+                                    const uint64 IN interval, void* IN udata)
+{
+    if (mCount == 0 && now > mCurrentTick)
+    {
+        mCurrentTick = now;
+    }
+    const int32 index = allocateNode();
+    Node& node = mNodes[index];
+    node.expires = now + delay;
+    node.interval = interval;
+    node.udata = udata;
+    const TimerID id = (static_cast<uint64>(node.generation) << 32) | static_cast<uint32>(index + 1);
+    if (node.expires < mCurrentTick)
+    {
+        // 휠이 이미 지나간 시각이라면 바로 만료 목록에 넣는다.
+        if (interval > 0)
+        {
+            node.expires = mCurrentTick + interval;
+            node.state = StateScheduled;
+            link(index);
+            ++mCount;
+        }
+        else
+        {
+            node.state = StateExpired;
+        }
+        mExpired.push_back(id);
+        return id;
+    }
+    node.state = StateScheduled;
+    link(index);
+    ++mCount;
+    return id;
+}
+
+bool TimerWheel::Cancel(const TimerID IN id)
+{
+    Node* node = findNode(id);
+    if (node == NULL)
+    {
+        return false;
+    }
+    const int32 index = static_cast<int32>(node - &mNodes[0]);
+    if (node->state == StateScheduled)
+    {
+        unlink(index);
+        --mCount;
+    }
+    releaseNode(index);
+    return true;
+}
+
+void TimerWheel::Advance(const uint64 IN now)
+{
+    if (mCount == 0)
+    {
+        if (now > mCurrentTick)
+        {
+            mCurrentTick = now;
+        }
+        return;
+    }
+    while (mCurrentTick <= now && mCount > 0)
+    {
+        const int32 index = static_cast<int32>(mCurrentTick & (ROOT_SIZE - 1));
+        if (index == 0)
+        {
+            for (int32 level = 1; level <= LEVEL_COUNT; ++level)
+            {
+                cascade(level);
+                const uint64 shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+                if (((mCurrentTick >> shift) & (LEVEL_SIZE - 1)) != 0)
+                {
+                    break;
+                }
+            }
+        }
+        expireSlot(index);
+        ++mCurrentTick;
+    }
+    if (mCount == 0 && now >= mCurrentTick)
+    {
+        mCurrentTick = now + 1;
+    }
+}
+
+bool TimerWheel::PopExpired(TimerID& OUT id, void*& OUT udata)
+{
+    while (mExpiredIndex < mExpired.size())
+    {
+        const TimerID current = mExpired[mExpiredIndex++];
+        Node* node = findNode(current);
+        if (node == NULL)
+        {
+            continue;
+        }
+        id = current;
+        udata = node->udata;
+        if (node->state == StateExpired)
+        {
+            releaseNode(static_cast<int32>(node - &mNodes[0]));
+        }
+        return true;
+    }
+    mExpired.clear();
+    mExpiredIndex = 0;
+    return false;
+}
+
+uint64 TimerWheel::GetExpiredCount() const
+{
+    return mExpired.size() - mExpiredIndex;
+}
+
+int64 TimerWheel::GetTimeout(const uint64 IN now) const
+{
+    if (mExpiredIndex < mExpired.size())
+    {
+        return 0;
+    }
+    if (mCount == 0)
+    {
+        return -1;
+    }
+    const uint64 index = mCurrentTick & (ROOT_SIZE - 1);
+    uint64 next = ~static_cast<uint64>(0);
+    // 첫 단계는 현재 칸부터 한 바퀴를 돌며 가장 가까운 칸을 찾는다.
+    for (uint64 offset = 0; offset < ROOT_SIZE; )
+    {
+        const uint64 slot = (index + offset) & (ROOT_SIZE - 1);
+        const uint64 word = mBitmaps[slot / 64] >> (slot % 64);
+        if (word != 0)
+        {
+            next = mCurrentTick + offset + __builtin_ctzll(word);
+            break;
+        }
+        offset += 64 - (slot % 64);
+    }
+    // 상위 단계에 타이머가 있다면 다음 cascade 시점에 다시 계산해야 한다.
+    for (int32 i = ROOT_SIZE / 64; i < BITMAP_COUNT; ++i)
+    {
+        if (mBitmaps[i] != 0)
+        {
+            const uint64 cascadeTick = (index == 0) ? mCurrentTick : mCurrentTick + (ROOT_SIZE - index);
+            if (cascadeTick < next)
+            {
+                next = cascadeTick;
+            }
+            break;
+        }
+    }
+    return (next > now) ? static_cast<int64>(next - now) : 0;
+}
+
+uint64 TimerWheel::GetCount() const
+{
+    return mCount;
+}
+
+int32 TimerWheel::allocateNode()
+{
+    if (mFreeHead != NIL)
+    {
+        const int32 index = mFreeHead;
+        mFreeHead = mNodes[index].next;
+        return index;
+    }
+    Node node;
+    node.expires = 0;
+    node.interval = 0;
+    node.udata = NULL;
+    node.prev = NIL;
+    node.next = NIL;
+    node.slot = NIL;
+    node.generation = 1;
+    node.state = StateFree;
+    mNodes.push_back(node);
+    return static_cast<int32>(mNodes.size() - 1);
+}
+
+void TimerWheel::releaseNode(const int32 index)
+{
+    Node& node = mNodes[index];
+    node.state = StateFree;
+    node.udata = NULL;
+    node.slot = NIL;
+    node.prev = NIL;
+    ++node.generation;
+    if (node.generation == 0)
+    {
+        node.generation = 1;
+    }
+    node.next = mFreeHead;
+    mFreeHead = index;
+}
+
+void TimerWheel::link(const int32 index)
+{
+    Node& node = mNodes[index];
+    uint64 delta = node.expires - mCurrentTick;
+    uint64 expires = node.expires;
+    if (delta > kMaxDelta)
+    {
+        // 표현 범위를 넘는 지연은 가장 먼 칸에 두고, cascade될 때 다시 배치한다.
+        delta = kMaxDelta;
+        expires = mCurrentTick + kMaxDelta;
+    }
+    int32 slot;
+    if (delta < ROOT_SIZE)
+    {
+        slot = static_cast<int32>(expires & (ROOT_SIZE - 1));
+    }
+    else
+    {
+        int32 level = 1;
+        uint64 shift = ROOT_BITS;
+        while (level < LEVEL_COUNT && delta >= (static_cast<uint64>(1) << (shift + LEVEL_BITS)))
+        {
+            ++level;
+            shift += LEVEL_BITS;
+        }
+        slot = ROOT_SIZE + (level - 1) * LEVEL_SIZE
+               + static_cast<int32>((expires >> shift) & (LEVEL_SIZE - 1));
+    }
+    node.slot = slot;
+    node.prev = NIL;
+    node.next = mHeads[slot];
+    if (node.next != NIL)
+    {
+        mNodes[node.next].prev = index;
+    }
+    mHeads[slot] = index;
+    mBitmaps[slot / 64] |= static_cast<uint64>(1) << (slot % 64);
+}
+
+void TimerWheel::unlink(const int32 index)
+{
+    Node& node = mNodes[index];
+    if (node.prev != NIL)
+    {
+        mNodes[node.prev].next = node.next;
+    }
+    else
+    {
+        mHeads[node.slot] = node.next;
+    }
+    if (node.next != NIL)
+    {
+        mNodes[node.next].prev = node.prev;
+    }
+    if (mHeads[node.slot] == NIL)
+    {
+        mBitmaps[node.slot / 64] &= ~(static_cast<uint64>(1) << (node.slot % 64));
+    }
+    node.slot = NIL;
+    node.prev = NIL;
+    node.next = NIL;
+}
+
+void TimerWheel::cascade(const int32 level)
+{
+    const uint64 shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+    const int32 slot = ROOT_SIZE + (level - 1) * LEVEL_SIZE
+                       + static_cast<int32>((mCurrentTick >> shift) & (LEVEL_SIZE - 1));
+    int32 index = mHeads[slot];
+    mHeads[slot] = NIL;
+    mBitmaps[slot / 64] &= ~(static_cast<uint64>(1) << (slot % 64));
+    while (index != NIL)
+    {
+        const int32 next = mNodes[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+void TimerWheel::expireSlot(const int32 slot)
+{
+    int32 index = mHeads[slot];
+    mHeads[slot] = NIL;
+    mBitmaps[slot / 64] &= ~(static_cast<uint64>(1) << (slot % 64));
+    while (index != NIL)
+    {
+        Node& node = mNodes[index];
+        const int32 next = node.next;
+        mExpired.push_back((static_cast<uint64>(node.generation) << 32) | static_cast<uint32>(index + 1));
+        if (node.interval > 0)
+        {
+            node.expires += node.interval;
+            if (node.expires <= mCurrentTick)
+            {
+                node.expires = mCurrentTick + 1;
+            }
+            link(index);
+        }
+        else
+        {
+            node.state = StateExpired;
+            node.slot = NIL;
+            node.prev = NIL;
+            node.next = NIL;
+            --mCount;
+        }
+        index = next;
+    }
+}
+
+TimerWheel::Node* TimerWheel::findNode(const TimerID id)
+{
+    const uint64 index = (id & 0xFFFFFFFFULL);
+    if (index == 0 || index > mNodes.size())
+    {
+        return NULL;
+    }
+    Node* node = &mNodes[index - 1];
+    if (node->state == StateFree || node->generation != static_cast<uint32>(id >> 32))
+    {
+        return NULL;
+    }
+    return node;
+}
+
+} // namespace gdf
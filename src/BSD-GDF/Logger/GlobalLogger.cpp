@@ -85,6 +85,7 @@ void GlobalLogger::SetLevel(eSeverityLevel level)
 GlobalLogger::LogStream::LogStream(eSeverityLevel level, const char* functionName,
                                    const char* fileName, const int lineNumber)
 : mLevel(level)
+, bIsEnabled(level <= GlobalLogger::GetInstance().mLevel)
 , mFunctionName(functionName)
 , mFileName(fileName)
 , mLineNumber(lineNumber)
@@ -92,7 +93,7 @@ GlobalLogger::LogStream::LogStream(eSeverityLevel level, const char* functionNam
 
 GlobalLogger::LogStream::~LogStream()
 {
-    if (mLevel <= GlobalLogger::GetInstance().mLevel)
+    if (bIsEnabled)
         GlobalLogger::GetInstance().Log(mLevel, mStream.str(),
                                         mFunctionName, mFileName,
                                         mLineNumber);
@@ -0,0 +1,100 @@
+#include "BSD-GDF/Network/BufferPool.hpp"
+
+#include <cstring>
+
+namespace gdf
+{
+
+BufferPool::BufferPool()
+: mAllocatedMemory(0)
+, mPooledMemory(0)
+, mLimit(kDefaultLimit)
+{
+    for (int32 i = 0; i < kClassCount; ++i)
+    {
+        mFreeLists[i] = NULL;
+    }
+}
+
+BufferPool::~BufferPool()
+{
+    Trim();
+}
+
+char* BufferPool::Allocate(const uint64 IN capacity)
+{
+    mAllocatedMemory += capacity;
+    const int32 index = getClassIndex(capacity);
+    if (index == -1 || mFreeLists[index] == NULL)
+    {
+        return new char[capacity];
+    }
+    char* data = mFreeLists[index];
+    std::memcpy(&mFreeLists[index], data, sizeof(char*));
+    mPooledMemory -= capacity;
+    return data;
+}
+
+void BufferPool::Release(char* IN data, const uint64 IN capacity)
+{
+    if (data == NULL)
+    {
+        return;
+    }
+    mAllocatedMemory -= capacity;
+    const int32 index = getClassIndex(capacity);
+    if (index == -1 || mPooledMemory + capacity > mLimit)
+    {
+        delete[] data;
+        return;
+    }
+    std::memcpy(data, &mFreeLists[index], sizeof(char*));
+    mFreeLists[index] = data;
+    mPooledMemory += capacity;
+}
+
+void BufferPool::SetLimit(const uint64 IN limit)
+{
+    mLimit = limit;
+    if (mPooledMemory > mLimit)
+    {
+        Trim();
+    }
+}
+
+void BufferPool::Trim()
+{
+    for (int32 i = 0; i < kClassCount; ++i)
+    {
+        while (mFreeLists[i] != NULL)
+        {
+            char* data = mFreeLists[i];
+            std::memcpy(&mFreeLists[i], data, sizeof(char*));
+            delete[] data;
+        }
+    }
+    mPooledMemory = 0;
+}
+
+uint64 BufferPool::GetAllocatedMemory() const
+{
+    return mAllocatedMemory;
+}
+
+uint64 BufferPool::GetPooledMemory() const
+{
+    return mPooledMemory;
+}
+
+int32 BufferPool::getClassIndex(const uint64 IN capacity)
+{
+    // 2의 거듭제곱이 아닌 크기는 보관하지 않는다.
+    if ((capacity & (capacity - 1)) != 0
+        || capacity < (static_cast<uint64>(1) << kMinClassBits) || capacity > (static_cast<uint64>(1) << kMaxClassBits))
+    {
+        return -1;
+    }
+    return __builtin_ctzll(capacity) - kMinClassBits;
+}
+
+}
@@ -0,0 +1,363 @@
+#include "BSD-GDF/Network/ByteBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "BSD-GDF/Network/BufferPool.hpp"
+#include "BSD-GDF/Network/DelimiterScanner.hpp"
+
+namespace gdf
+{
+
+namespace
+{
+    /**
+     * 처음 할당할 때의 최소 크기.
+     */
+    const uint64 kMinCapacity = 64;
+}
+
+const uint64 ByteBuffer::NPOS;
+
+ByteBuffer::ByteBuffer()
+: mData(NULL)
+, mCapacity(0)
+, mHead(0)
+, mSize(0)
+, mPool(NULL)
+{
+
+}
+
+ByteBuffer::ByteBuffer(const ByteBuffer& buffer)
+: mData(NULL)
+, mCapacity(0)
+, mHead(0)
+, mSize(0)
+, mPool(NULL)
+{
+    *this = buffer;
+}
+
+ByteBuffer& ByteBuffer::operator=(const ByteBuffer& buffer)
+{
+    if (this == &buffer)
+    {
+        return *this;
+    }
+    Clear();
+    Reserve(buffer.mSize);
+    const uint64 first = buffer.GetContiguousSize();
+    Append(buffer.GetContiguousData(), first);
+    Append(buffer.mData, buffer.mSize - first);
+    return *this;
+}
+
+ByteBuffer::~ByteBuffer()
+{
+    deallocate(mData, mCapacity);
+}
+
+void ByteBuffer::Append(const char* IN data, const uint64 IN size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    if (mSize + size > mCapacity)
+    {
+        grow(mSize + size);
+    }
+    // 끝에 닿으면 나머지는 앞에서부터 이어서 쓴다.
+    const uint64 tail = (mHead + mSize) & (mCapacity - 1);
+    const uint64 first = (size < mCapacity - tail) ? size : mCapacity - tail;
+    std::memcpy(mData + tail, data, first);
+    std::memcpy(mData, data + first, size - first);
+    mSize += size;
+}
+
+void ByteBuffer::Consume(const uint64 IN size)
+{
+    if (size >= mSize)
+    {
+        Clear();
+        return;
+    }
+    mHead = (mHead + size) & (mCapacity - 1);
+    mSize -= size;
+}
+
+void ByteBuffer::Clear()
+{
+    mHead = 0;
+    mSize = 0;
+}
+
+void ByteBuffer::Reserve(const uint64 IN capacity)
+{
+    if (capacity > mCapacity)
+    {
+        grow(capacity);
+    }
+}
+
+void ByteBuffer::Swap(ByteBuffer& IN OUT buffer)
+{
+    char* data = mData;
+    const uint64 capacity = mCapacity;
+    const uint64 head = mHead;
+    const uint64 size = mSize;
+    BufferPool* pool = mPool;
+    mData = buffer.mData;
+    mCapacity = buffer.mCapacity;
+    mHead = buffer.mHead;
+    mSize = buffer.mSize;
+    mPool = buffer.mPool;
+    buffer.mData = data;
+    buffer.mCapacity = capacity;
+    buffer.mHead = head;
+    buffer.mSize = size;
+    buffer.mPool = pool;
+}
+
+void ByteBuffer::SetPool(BufferPool* IN pool)
+{
+    if (mData == NULL)
+    {
+        mPool = pool;
+    }
+}
+
+void ByteBuffer::ReleaseMemory()
+{
+    if (mSize == 0 && mData != NULL)
+    {
+        deallocate(mData, mCapacity);
+        mData = NULL;
+        mCapacity = 0;
+        mHead = 0;
+    }
+}
+
+uint64 ByteBuffer::Size() const
+{
+    return mSize;
+}
+
+bool ByteBuffer::Empty() const
+{
+    return mSize == 0;
+}
+
+uint64 ByteBuffer::Capacity() const
+{
+    return mCapacity;
+}
+
+const char* ByteBuffer::GetContiguousData() const
+{
+    return (mData == NULL) ? NULL : mData + mHead;
+}
+
+uint64 ByteBuffer::GetContiguousSize() const
+{
+    return (mSize < mCapacity - mHead) ? mSize : mCapacity - mHead;
+}
+
+const char* ByteBuffer::Linearize()
+{
+    if (GetContiguousSize() < mSize)
+    {
+        // 메모리 전체를 mHead만큼 왼쪽으로 회전하면 데이터가 0부터 연속으로 놓인다.
+        std::rotate(mData, mData + mHead, mData + mCapacity);
+        mHead = 0;
+    }
+    return GetContiguousData();
+}
+
+uint32 ByteBuffer::GetReadRegions(struct iovec* OUT regions) const
+{
+    return GetReadRegions(regions, 0, mSize);
+}
+
+uint32 ByteBuffer::GetReadRegions(struct iovec* OUT regions, const uint64 IN offset, const uint64 IN size) const
+{
+    const uint64 length = (size < mSize - offset) ? size : mSize - offset;
+    if (length == 0)
+    {
+        return 0;
+    }
+    const uint64 position = (mHead + offset) & (mCapacity - 1);
+    const uint64 first = (length < mCapacity - position) ? length : mCapacity - position;
+    regions[0].iov_base = mData + position;
+    regions[0].iov_len = first;
+    if (first == length)
+    {
+        return 1;
+    }
+    regions[1].iov_base = mData;
+    regions[1].iov_len = length - first;
+    return 2;
+}
+
+uint64 ByteBuffer::Find(const char* IN pattern, const uint64 IN patternSize, const uint64 IN offset) const
+{
+    if (patternSize == 0)
+    {
+        return (offset <= mSize) ? offset : NPOS;
+    }
+    if (offset > mSize)
+    {
+        return NPOS;
+    }
+    if (patternSize == 1 || (patternSize == 2 && pattern[0] == '\r' && pattern[1] == '\n'))
+    {
+        return findDelimiter(pattern, patternSize, offset);
+    }
+    uint64 index = offset;
+    while (index + patternSize <= mSize)
+    {
+        // 패턴의 첫 바이트는 연속된 구간마다 memchr()로 찾고, 나머지는 matchAt()으로 확인한다.
+        const uint64 position = (mHead + index) & (mCapacity - 1);
+        uint64 length = mSize - patternSize + 1 - index;
+        if (length > mCapacity - position)
+        {
+            length = mCapacity - position;
+        }
+        const char* found = static_cast<const char*>(std::memchr(mData + position, pattern[0], length));
+        if (found == NULL)
+        {
+            index += length;
+            continue;
+        }
+        index += static_cast<uint64>(found - (mData + position));
+        if (matchAt(index, pattern, patternSize))
+        {
+            return index;
+        }
+        ++index;
+    }
+    return NPOS;
+}
+
+void ByteBuffer::CopyTo(std::string& OUT out, const uint64 IN size) const
+{
+    const uint64 length = (size < mSize) ? size : mSize;
+    if (length == 0)
+    {
+        out.clear();
+        return;
+    }
+    const uint64 first = (length < GetContiguousSize()) ? length : GetContiguousSize();
+    out.assign(mData + mHead, first);
+    out.append(mData, length - first);
+}
+
+uint64 ByteBuffer::CopyTo(char* OUT out, const uint64 IN size) const
+{
+    const uint64 length = (size < mSize) ? size : mSize;
+    if (length == 0)
+    {
+        return 0;
+    }
+    const uint64 first = (length < GetContiguousSize()) ? length : GetContiguousSize();
+    std::memcpy(out, mData + mHead, first);
+    std::memcpy(out + first, mData, length - first);
+    return length;
+}
+
+uint32 ByteBuffer::GetWriteRegions(struct iovec* OUT regions, const uint64 IN size)
+{
+    if (mCapacity - mSize < size)
+    {
+        grow(mSize + size);
+    }
+    const uint64 tail = (mHead + mSize) & (mCapacity - 1);
+    const uint64 space = mCapacity - mSize;
+    const uint64 first = (space < mCapacity - tail) ? space : mCapacity - tail;
+    regions[0].iov_base = mData + tail;
+    regions[0].iov_len = first;
+    if (first == space)
+    {
+        return 1;
+    }
+    regions[1].iov_base = mData;
+    regions[1].iov_len = space - first;
+    return 2;
+}
+
+void ByteBuffer::Commit(const uint64 IN size)
+{
+    mSize += size;
+}
+
+void ByteBuffer::grow(const uint64 IN capacity)
+{
+    uint64 newCapacity = (mCapacity == 0) ? kMinCapacity : mCapacity;
+    while (newCapacity < capacity)
+    {
+        newCapacity <<= 1;
+    }
+    char* newData = allocate(newCapacity);
+    const uint64 first = GetContiguousSize();
+    if (mSize > 0)
+    {
+        std::memcpy(newData, mData + mHead, first);
+        std::memcpy(newData + first, mData, mSize - first);
+    }
+    deallocate(mData, mCapacity);
+    mData = newData;
+    mCapacity = newCapacity;
+    mHead = 0;
+}
+
+char* ByteBuffer::allocate(const uint64 IN capacity)
+{
+    return (mPool == NULL) ? new char[capacity] : mPool->Allocate(capacity);
+}
+
+void ByteBuffer::deallocate(char* IN data, const uint64 IN capacity)
+{
+    if (mPool == NULL)
+    {
+        delete[] data;
+        return;
+    }
+    mPool->Release(data, capacity);
+}
+
+uint64 ByteBuffer::findDelimiter(const char* IN pattern, const uint64 IN patternSize, const uint64 IN offset) const
+{
+    struct iovec regions[2];
+    const uint32 regionCount = GetReadRegions(regions, offset, mSize - offset);
+    uint64 base = offset;
+    for (uint32 i = 0; i < regionCount; ++i)
+    {
+        const char* begin = static_cast<const char*>(regions[i].iov_base);
+        const char* end = begin + regions[i].iov_len;
+        const char* found = (patternSize == 1) ? DelimiterScanner::FindByte(begin, end, pattern[0])
+                                               : DelimiterScanner::FindCRLF(begin, end);
+        if (found != NULL)
+        {
+            return base + static_cast<uint64>(found - begin);
+        }
+        // "\r\n"이 링 버퍼의 끝에서 나뉘어 있는 경우
+        if (patternSize == 2 && i + 1 < regionCount
+            && end[-1] == '\r' && static_cast<const char*>(regions[i + 1].iov_base)[0] == '\n')
+        {
+            return base + regions[i].iov_len - 1;
+        }
+        base += regions[i].iov_len;
+    }
+    return NPOS;
+}
+
+bool ByteBuffer::matchAt(const uint64 IN index, const char* IN pattern, const uint64 IN patternSize) const
+{
+    const uint64 position = (mHead + index) & (mCapacity - 1);
+    const uint64 first = (patternSize < mCapacity - position) ? patternSize : mCapacity - position;
+    return std::memcmp(mData + position, pattern, first) == 0
+           && std::memcmp(mData, pattern + first, patternSize - first) == 0;
+}
+
+}
@@ -0,0 +1,141 @@
+#include "BSD-GDF/Network/DelimiterScanner.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace gdf
+{
+
+namespace
+{
+    const char* findCRLFScalar(const char* begin, const char* end)
+    {
+        for (const char* p = begin; p + 1 < end; ++p)
+        {
+            if (p[0] == '\r' && p[1] == '\n')
+            {
+                return p;
+            }
+        }
+        return NULL;
+    }
+
+#if defined(__x86_64__)
+    bool hasAVX2()
+    {
+        static const bool bHasAVX2 = __builtin_cpu_supports("avx2");
+        return bHasAVX2;
+    }
+
+    const char* findByteSSE2(const char* begin, const char* end, const char byte)
+    {
+        const __m128i needle = _mm_set1_epi8(byte);
+        const char* p = begin;
+        for (; p + 16 <= end; p += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const int32 mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+            if (mask != 0)
+            {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return static_cast<const char*>(std::memchr(p, byte, end - p));
+    }
+
+    const char* findCRLFSSE2(const char* begin, const char* end)
+    {
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const char* p = begin;
+        // p와 p + 1에서 읽은 블록을 비교하여 '\r' 다음 바이트가 '\n'인 위치를 찾는다.
+        for (; p + 17 <= end; p += 16)
+        {
+            const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+            const int32 mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, cr), _mm_cmpeq_epi8(second, lf)));
+            if (mask != 0)
+            {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return findCRLFScalar(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char* findByteAVX2(const char* begin, const char* end, const char byte)
+    {
+        const __m256i needle = _mm256_set1_epi8(byte);
+        const char* p = begin;
+        for (; p + 32 <= end; p += 32)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const uint32 mask = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            if (mask != 0)
+            {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return findByteSSE2(p, end, byte);
+    }
+
+    __attribute__((target("avx2")))
+    const char* findCRLFAVX2(const char* begin, const char* end)
+    {
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const char* p = begin;
+        for (; p + 33 <= end; p += 32)
+        {
+            const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+            const uint32 mask = static_cast<uint32>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(first, cr), _mm256_cmpeq_epi8(second, lf))));
+            if (mask != 0)
+            {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return findCRLFSSE2(p, end);
+    }
+#endif
+}
+
+const char* DelimiterScanner::FindByte(const char* IN begin, const char* IN end, const char IN byte)
+{
+    if (begin >= end)
+    {
+        return NULL;
+    }
+#if defined(__x86_64__)
+    if (hasAVX2())
+    {
+        return findByteAVX2(begin, end, byte);
+    }
+    return findByteSSE2(begin, end, byte);
+#else
+    return static_cast<const char*>(std::memchr(begin, byte, end - begin));
+#endif
+}
+
+const char* DelimiterScanner::FindCRLF(const char* IN begin, const char* IN end)
+{
+    if (begin >= end)
+    {
+        return NULL;
+    }
+#if defined(__x86_64__)
+    if (hasAVX2())
+    {
+        return findCRLFAVX2(begin, end);
+    }
+    return findCRLFSSE2(begin, end);
+#else
+    return findCRLFScalar(begin, end);
+#endif
+}
+
+}
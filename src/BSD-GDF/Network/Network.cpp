@@ -1,10 +1,62 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "BSD-GDF/Network/Network.hpp"
 
+#include <new>
+
 namespace gdf
 {
 
+namespace
+{
+    enum eOperation
+    {
+        OperationAccept = 1,
+        OperationRecv,
+        OperationSend
+    };
+
+    /**
+     * 연결이 끊긴 소켓에 보낼 때 SIGPIPE로 프로세스가 종료되지 않도록 하는 플래그.
+     */
+#if defined(MSG_NOSIGNAL)
+    const int32 kSendFlags = MSG_NOSIGNAL;
+#else
+    const int32 kSendFlags = 0;
+#endif
+
+    /**
+     * 데이터를 문자열로 복사하지 않고 로그에 출력하기 위한 구조체.
+     */
+    struct LogBytes
+    {
+        const char* data;
+        uint64 size;
+    };
+
+    std::ostream& operator<<(std::ostream& stream, const LogBytes& bytes)
+    {
+        return stream.write(bytes.data, static_cast<std::streamsize>(bytes.size));
+    }
+}
+
 Network::Network()
 : mServerSocket(ERROR)
+, mSessionCount(0)
+, mCompletionQueue(NULL)
+, bIsDraining(false)
+, mRecvChunkSize(kDefaultRecvChunkSize)
+, mRecvBudget(kDefaultRecvBudget)
+, mFrameLengthSize(kDefaultFrameLengthSize)
+, mMaxFrameSize(kDefaultMaxFrameSize)
+, mSendHighWatermark(0)
+, mSendLowWatermark(0)
+, mSlowConsumerPolicy(SlowConsumerNotify)
+, mSlowConsumerHandler(NULL)
+, mMessageBudget(0)
+, mIteration(0)
 {
 
 }
@@ -12,16 +64,28 @@ Network::Network()
 Network::~Network()
 {
     close(mServerSocket);
-    mSessions.clear();
+    for (std::size_t i = 0; i < mSessionChunks.size(); ++i)
+    {
+        delete[] mSessionChunks[i];
+    }
+    mSessionChunks.clear();
+    for (std::size_t i = 0; i < mOrphanSends.size(); ++i)
+    {
+        delete mOrphanSends[i];
+    }
+    for (std::size_t i = 0; i < mFreeInflightSends.size(); ++i)
+    {
+        delete mFreeInflightSends[i];
+    }
 }
 
-bool Network::Init(const int32 IN port)
+bool Network::Init(const int32 IN port, const bool IN bReusePort)
 {
     if (createServerSocket() == FAILURE)
     {
         return FAILURE;
     }
-    if (setServerSocket(port) == FAILURE)
+    if (setServerSocket(port, bReusePort) == FAILURE)
     {
         close(mServerSocket);
         return FAILURE;
@@ -31,81 +95,191 @@ bool Network::Init(const int32 IN port)
 
 int32 Network::ConnectNewClient()
 {
+    if (bIsDraining)
+    {
+        return ERROR;
+    }
     // client 연결
     sockaddr_in clientAddr;
-    std::memset(&clientAddr, 0, sizeof(clientAddr));
-    socklen_t clientAddrLength = sizeof(clientAddr);
-    int32 clientSocket = accept(mServerSocket, (sockaddr*)&clientAddr, &clientAddrLength);
+    int32 clientSocket = acceptClient(clientAddr);
     if (clientSocket == ERROR)
     {
         LOG(LogLevel::Error) << "Failed to connect client on server socket"
             << "(errno: " << errno << " - " << strerror(errno) << ") on accept()";
         return ERROR;
     }
-    // client socket non-blocking 설정
-    if (fcntl(clientSocket, F_SETFL, O_NONBLOCK) == ERROR)
+    // client session 추가
+    if (addSession(clientSocket, clientAddr) == FAILURE)
     {
-        LOG(LogLevel::Error) << "Failed to set non-blocking fd on client socket"
-            << "(errno: " << errno << " - " << strerror(errno) << ") on fcntl()";
-        close(clientSocket);
         return ERROR;
     }
-    // client session 추가
-    mSessions[clientSocket].addr = clientAddr;
-    mSessions[clientSocket].socket = clientSocket;
-    mSessions[clientSocket].recvBuffer.reserve(1024);
-    mSessions[clientSocket].sendBufferRemain = false;
-    mSessions[clientSocket].sendBufferIndex = 0;
-    mSessions[clientSocket].sendBuffer.reserve(1024);
-    mSessions[clientSocket].isReservedDisconnect = false;
     return clientSocket;
 }
 
+uint64 Network::ConnectNewClients(std::vector<int32>& OUT sockets, const uint64 IN maxCount)
+{
+    if (bIsDraining)
+    {
+        return 0;
+    }
+    uint64 count = 0;
+    while (count < maxCount)
+    {
+        sockaddr_in clientAddr;
+        int32 clientSocket = acceptClient(clientAddr);
+        if (clientSocket == ERROR)
+        {
+            // 연결 요청이 도착한 뒤 취소된 경우는 건너뛰고 계속 받는다.
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            // 대기 중인 연결 요청을 모두 받은 경우
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            LOG(LogLevel::Error) << "Failed to connect client on server socket"
+                << "(errno: " << errno << " - " << strerror(errno) << ") on accept()";
+            break;
+        }
+        if (addSession(clientSocket, clientAddr) == FAILURE)
+        {
+            break;
+        }
+        sockets.push_back(clientSocket);
+        ++count;
+    }
+    return count;
+}
+
 void Network::DisconnectClient(const int32 IN socket)
 {
     LOG(LogLevel::Notice) << "Client(IP: " << GetIPString(socket) << ") disconnected";
+    if (mCompletionQueue != NULL)
+    {
+        // 진행 중인 multishot recv가 소켓을 붙잡고 있으므로 shutdown()으로 먼저 끝낸다.
+        shutdown(socket, SHUT_RDWR);
+    }
     close(socket);
-    mSessions.erase(socket);
+    removeSession(socket);
 }
 
 bool Network::RecvFromClient(const int32 IN socket)
 {
     // client로부터 메세지 수신 시도
-    struct Session& session = mSessions[socket];
-    if (session.isReservedDisconnect)
+    struct Session* found = findSession(socket);
+    if (found == NULL)
+    {
+        LOG(LogLevel::Warning) << "Failed to receive message from unknown socket(" << socket << ")";
+        return FAILURE;
+    }
+    struct Session& session = *found;
+    if (session.isReservedDisconnect || session.isReadPaused)
     {
         return SUCCESS;
     }
-    char buffer[kRecvBufferSize];
-    int32 recvLen = recv(socket, buffer, kRecvBufferSize - 1, 0);
-    // 오류 발생시
-    if (recvLen == ERROR)
+    // 이번 바퀴의 budget을 이미 다 써서 넘겨진 세션은 다음 바퀴에서 TakeCarriedSessions()로 꺼낸 뒤 받는다.
+    // (TakeCarriedSessions()를 호출하지 않는 루프라면 넘겨진 세션이 꺼내지지 않으므로 확인하지 않는다)
+    if (session.isCarried && mIteration != 0)
     {
-        LOG(LogLevel::Error) << "Failed to receive message from client(" << GetIPString(socket) << ")"
-            << "(errno:" << errno << " - " << strerror(errno) << ") on recv()";
-        close(socket);
-        mSessions.erase(socket);
-        return FAILURE;
+        return SUCCESS;
     }
-    // 상대방과 연결이 끊긴 경우
-    else if (recvLen == 0)
+    // 비어서 반환했던 버퍼라면 직전에 사용한 크기만큼 한 번에 받아, 작은 크기부터 다시 늘려가지 않도록 한다.
+    if (session.recvBuffer.Capacity() == 0 && session.recvCapacityHint > 0)
     {
-        LOG(LogLevel::Notice) << "Client(IP: " << GetIPString(socket) << ") disconnected";
-        close(socket);
-        mSessions.erase(socket);
-        return FAILURE;
+        session.recvBuffer.Reserve(session.recvCapacityHint);
+    }
+    // 소켓이 빌 때까지(또는 budget만큼) recvBuffer의 빈 공간에 직접 받는다.
+    uint64 totalLen = 0;
+    bool bIsDrained = false;
+    while (totalLen < mRecvBudget)
+    {
+        struct iovec regions[2];
+        const uint32 regionCount = session.recvBuffer.GetWriteRegions(regions, mRecvChunkSize);
+        const uint64 spaceLen = regions[0].iov_len + ((regionCount == 2) ? regions[1].iov_len : 0);
+        ssize_t recvLen = readv(socket, regions, regionCount);
+        // 오류 발생시
+        if (recvLen == ERROR)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                bIsDrained = true;
+                break;
+            }
+            LOG(LogLevel::Error) << "Failed to receive message from client(" << GetIPString(socket) << ")"
+                << "(errno:" << errno << " - " << strerror(errno) << ") on readv()";
+            close(socket);
+            removeSession(socket);
+            return FAILURE;
+        }
+        // 상대방과 연결이 끊긴 경우 (받은 데이터가 있다면 먼저 처리하도록 다음 호출로 미룬다)
+        else if (recvLen == 0)
+        {
+            if (totalLen > 0)
+            {
+                break;
+            }
+            LOG(LogLevel::Notice) << "Client(IP: " << GetIPString(socket) << ") disconnected";
+            close(socket);
+            removeSession(socket);
+            return FAILURE;
+        }
+        session.recvBuffer.Commit(static_cast<uint64>(recvLen));
+        totalLen += static_cast<uint64>(recvLen);
+        // 빈 공간을 다 채우지 못했다면 소켓이 비었으므로, EAGAIN을 확인하는 시스템 콜을 생략한다.
+        if (static_cast<uint64>(recvLen) < spaceLen)
+        {
+            bIsDrained = true;
+            break;
+        }
+    }
+    // budget을 다 써서 소켓에 데이터가 남았을 수 있다면 다음 바퀴에서 이어서 받도록 넘긴다.
+    if (bIsDrained == false)
+    {
+        carrySession(session);
+    }
+    // 확보한 크기의 1/4도 받지 못했다면 다음에 확보할 크기를 절반으로 줄인다.
+    uint64 capacity = session.recvBuffer.Capacity();
+    if (capacity > kMaxRecvCapacityHint)
+    {
+        capacity = kMaxRecvCapacityHint;
+    }
+    session.recvCapacityHint = static_cast<uint32>((totalLen * 4 < capacity) ? capacity / 2 : capacity);
+    if (totalLen == 0)
+    {
+        // 받은 데이터가 없다면 readv()를 위해 확보한 빈 공간을 돌려준다.
+        releaseIdleBuffers(session);
     }
     // 메시지 수신 완료
-    buffer[recvLen] = '\0';
-    session.recvBuffer += buffer;
     LOG(LogLevel::Notice) << "Received message from client(" << GetIPString(socket) << ") "
-        << std::strlen(buffer) << "bytes\n" << buffer;
+        << totalLen << "bytes";
     return SUCCESS;
 }
 
+void Network::SetRecvOptions(const uint64 IN chunkSize, const uint64 IN budget)
+{
+    mRecvChunkSize = (chunkSize == 0) ? static_cast<uint64>(kDefaultRecvChunkSize) : chunkSize;
+    mRecvBudget = (budget == 0) ? static_cast<uint64>(kDefaultRecvBudget) : budget;
+}
+
 bool Network::SendToClient(const int32 IN socket)
 {
-    struct Session& session = mSessions[socket];
+    struct Session* found = findSession(socket);
+    if (found == NULL)
+    {
+        LOG(LogLevel::Warning) << "Failed to send message to unknown socket(" << socket << ")";
+        return FAILURE;
+    }
+    struct Session& session = *found;
+    if (mCompletionQueue != NULL)
+    {
+        return submitSend(session);
+    }
     if (session.sendBufferRemain == false)
     {
         if (session.isReservedDisconnect)
@@ -114,87 +288,536 @@ bool Network::SendToClient(const int32 IN socket)
         }
         return SUCCESS;
     }
-    const char* c_sendBuffer = session.sendBuffer.c_str();
-    uint64 remainLen = std::strlen(c_sendBuffer + session.sendBufferIndex);
-    int sendLen = send(socket,
-                       c_sendBuffer + session.sendBufferIndex,
-                       remainLen,
-                       0);
+    // 복사된 데이터와 SharedBuffer의 데이터 구간을 모아 한 번에 보낸다.
+    struct iovec regions[kMaxSendRegions];
+    struct msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = regions;
+    message.msg_iovlen = session.sendBuffer.GetReadRegions(regions, kMaxSendRegions);
+    ssize_t sendLen = sendmsg(socket, &message, kSendFlags);
     // 오류 발생시
     if (sendLen == -1)
     {
+        // 소켓의 send buffer가 가득 찬 경우, 남은 데이터는 다음 쓰기 이벤트에서 보낸다.
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            return SUCCESS;
+        }
         LOG(LogLevel::Error) << "Failed to send message to client(" << GetIPString(socket) << ")"
-            << "(errno:" << errno << " - " << strerror(errno) << ") on send()";
+            << "(errno:" << errno << " - " << strerror(errno) << ") on sendmsg()";
         close(socket);
-        mSessions.erase(socket);
+        removeSession(socket);
         return FAILURE;
     }
     // 메세지 전송 완료
+    const LogBytes sentBytes = {
+        static_cast<const char*>(regions[0].iov_base),
+        (static_cast<uint64>(sendLen) < regions[0].iov_len) ? sendLen : regions[0].iov_len
+    };
     LOG(LogLevel::Notice) << "Sent message to client(" << GetIPString(socket) << ") "
-        << sendLen << "bytes\n" << c_sendBuffer + session.sendBufferIndex;
+        << sendLen << "bytes\n" << sentBytes;
 
-    session.sendBufferIndex += static_cast<uint64>(sendLen);
-    if (static_cast<uint64>(sendLen) == remainLen)
+    session.sendBuffer.Consume(static_cast<uint64>(sendLen));
+    if (session.sendBuffer.Empty())
     {
         session.sendBufferRemain = false;
-        session.sendBufferIndex = 0;
-        session.sendBuffer.clear();
+        releaseIdleBuffers(session);
     }
     LOG(LogLevel::Debug) << "Sent message to client(" << GetIPString(socket) << ") "
         << sendLen << "bytes";
-    return SUCCESS;
+    return checkSendWatermark(session);
 }
 
-void Network::PushToSendBuffer(const int32 IN socket, const std::string& IN buf)
+bool Network::PushToSendBuffer(const int32 IN socket, const std::string& IN buf)
 {
-    struct Session& session = mSessions[socket];
-    session.sendBuffer.erase(0, session.sendBufferIndex);
-    session.sendBufferIndex = 0;
-    session.sendBuffer += buf;
+    return PushToSendBuffer(socket, buf.data(), buf.size());
+}
+
+bool Network::PushToSendBuffer(const int32 IN socket, const char* IN data, const uint64 IN size)
+{
+    struct Session* found = findSession(socket);
+    if (found == NULL)
+    {
+        LOG(LogLevel::Warning) << "Failed to push message to unknown socket(" << socket << ")";
+        return FAILURE;
+    }
+    struct Session& session = *found;
+    session.sendBuffer.Append(data, size);
     session.sendBufferRemain = true;
+    queueFlush(session);
+    return checkSendWatermark(session);
+}
+
+bool Network::PushToSendBuffer(const int32 IN socket, const SharedBuffer& IN buffer)
+{
+    struct Session* session = findSession(socket);
+    if (session == NULL)
+    {
+        LOG(LogLevel::Warning) << "Failed to push message to unknown socket(" << socket << ")";
+        return FAILURE;
+    }
+    session->sendBuffer.Append(buffer);
+    session->sendBufferRemain = true;
+    queueFlush(*session);
+    return checkSendWatermark(*session);
+}
+
+bool Network::BroadcastToClients(const std::vector<int32>& IN sockets, const SharedBuffer& IN buffer)
+{
+    bool result = SUCCESS;
+    for (std::size_t i = 0; i < sockets.size(); ++i)
+    {
+        struct Session* session = findSession(sockets[i]);
+        if (session == NULL)
+        {
+            continue;
+        }
+        session->sendBuffer.Append(buffer);
+        session->sendBufferRemain = true;
+        queueFlush(*session);
+        if (checkSendWatermark(*session) == FAILURE)
+        {
+            result = FAILURE;
+        }
+    }
+    return result;
 }
 
 bool Network::PullFromRecvBuffer(const int32 IN socket, std::string& OUT buf, const std::string& IN endString)
 {
+    struct Session* session = findSession(socket);
+    if (session == NULL || getMessageBudget(*session) == 0)
+    {
+        return false;
+    }
     if (endString == "\0")
     {
-        if (mSessions[socket].recvBuffer.size() == 0)
+        if (session->recvBuffer.Empty())
         {
             return false;
         }
         else
         {
-            buf = mSessions[socket].recvBuffer;
-            mSessions[socket].recvBuffer.clear();
+            session->recvBuffer.CopyTo(buf, session->recvBuffer.Size());
+            consumeRecvBuffer(*session, session->recvBuffer.Size());
+            ++session->iterationMessages;
             return true;
         }
     }
-    const std::size_t subStrLen = mSessions[socket].recvBuffer.find(endString);
-    if (subStrLen == std::string::npos)
+    updateScanDelimiter(*session, endString);
+    const uint64 subStrLen = session->recvBuffer.Find(endString.data(), endString.size(), session->scanOffset);
+    if (subStrLen == ByteBuffer::NPOS)
     {
+        // 구분자가 뒤에 이어질 데이터와 합쳐질 수 있으므로 마지막 (구분자 길이 - 1) 바이트는 다시 확인한다.
+        const uint64 size = session->recvBuffer.Size();
+        session->scanOffset = (size >= endString.size()) ? size - endString.size() + 1 : 0;
         return false;
     }
-    buf = mSessions[socket].recvBuffer.substr(0, subStrLen);
-    mSessions[socket].recvBuffer.erase(0, subStrLen + endString.size());
+    session->recvBuffer.CopyTo(buf, subStrLen);
+    consumeRecvBuffer(*session, subStrLen + endString.size());
+    ++session->iterationMessages;
     return true;
 }
 
+uint64 Network::PeekMessages(const int32 IN socket, std::vector<struct MessageView>& OUT views, const std::string& IN endString)
+{
+    views.clear();
+    struct Session* session = findSession(socket);
+    if (session == NULL || session->recvBuffer.Empty())
+    {
+        return 0;
+    }
+    // CommitMessages() 전에 다시 호출된 경우, 이미 돌려준 메세지(peekedSize까지)는 다시 세지 않는다.
+    const uint64 peeked = session->peekedSize;
+    const uint64 budget = getMessageBudget(*session);
+    if (budget == 0 && peeked == 0)
+    {
+        return 0;
+    }
+    // 메세지가 링 버퍼의 끝에서 나뉘지 않도록 데이터를 연속으로 만든다. (할당 없이 회전만 하며, 이미 연속이라면 아무것도 하지 않는다)
+    const char* data = session->recvBuffer.Linearize();
+    const uint64 size = session->recvBuffer.Size();
+    struct MessageView view;
+    if (endString == "\0")
+    {
+        view.data = data;
+        view.size = size;
+        views.push_back(view);
+        session->peekedSize = size;
+        if (peeked == 0)
+        {
+            ++session->iterationMessages;
+        }
+        return 1;
+    }
+    updateScanDelimiter(*session, endString);
+    uint64 offset = 0;
+    uint64 newCount = 0;
+    uint64 found = session->recvBuffer.Find(endString.data(), endString.size(), session->scanOffset);
+    while (found != ByteBuffer::NPOS)
+    {
+        const bool bIsNew = (offset >= peeked);
+        if (bIsNew && newCount == budget)
+        {
+            // 남은 메세지는 다음 바퀴에서 가져오도록 넘긴다.
+            carrySession(*session);
+            break;
+        }
+        view.data = data + offset;
+        view.size = found - offset;
+        views.push_back(view);
+        if (bIsNew)
+        {
+            ++newCount;
+        }
+        offset = found + endString.size();
+        found = session->recvBuffer.Find(endString.data(), endString.size(), offset);
+    }
+    session->peekedSize = offset;
+    session->iterationMessages += static_cast<uint32>(newCount);
+    if (views.empty())
+    {
+        // PullFromRecvBuffer()와 같이 다음 호출에서는 새로 도착한 데이터만 확인한다.
+        session->scanOffset = (size >= endString.size()) ? size - endString.size() + 1 : 0;
+    }
+    return views.size();
+}
+
+void Network::CommitMessages(const int32 IN socket)
+{
+    struct Session* session = findSession(socket);
+    if (session != NULL && session->peekedSize > 0)
+    {
+        consumeRecvBuffer(*session, session->peekedSize);
+    }
+}
+
+void Network::FlushSendBuffers()
+{
+    // SendToClient()가 세션을 종료하거나 다시 추가할 수 있으므로 목록을 비운 뒤 순회한다.
+    std::vector<int32> flushList;
+    flushList.swap(mFlushList);
+    for (std::size_t i = 0; i < flushList.size(); ++i)
+    {
+        // 종료된 세션의 항목이라도 소켓 번호가 재사용될 수 있으므로 슬롯의 표시는 항상 내린다.
+        const int32 socket = flushList[i];
+        struct Session& slot = mSessionChunks[socket >> kSessionChunkBits][socket & (kSessionChunkSize - 1)];
+        slot.isFlushQueued = false;
+        if (slot.isActive)
+        {
+            SendToClient(socket);
+        }
+    }
+    // 다음 호출에서 메모리를 다시 할당하지 않도록 목록의 용량을 되돌려 놓는다.
+    if (mFlushList.empty())
+    {
+        flushList.clear();
+        mFlushList.swap(flushList);
+    }
+}
+
+bool Network::SetFrameFormat(const uint32 IN lengthSize, const uint64 IN maxFrameSize)
+{
+    if (lengthSize != 1 && lengthSize != 2 && lengthSize != 4 && lengthSize != 8)
+    {
+        LOG(LogLevel::Error) << "Invalid frame length size(" << lengthSize << ")";
+        return FAILURE;
+    }
+    mFrameLengthSize = lengthSize;
+    mMaxFrameSize = maxFrameSize;
+    return SUCCESS;
+}
+
+bool Network::PullFrameFromRecvBuffer(const int32 IN socket, std::string& OUT buf)
+{
+    struct Session* session = findSession(socket);
+    if (session == NULL || session->recvBuffer.Size() < mFrameLengthSize || getMessageBudget(*session) == 0)
+    {
+        return false;
+    }
+    // big-endian 길이 필드를 읽는다.
+    uint8 header[8];
+    session->recvBuffer.CopyTo(reinterpret_cast<char*>(header), mFrameLengthSize);
+    uint64 frameSize = 0;
+    for (uint32 i = 0; i < mFrameLengthSize; ++i)
+    {
+        frameSize = (frameSize << 8) | header[i];
+    }
+    if (frameSize > mMaxFrameSize)
+    {
+        LOG(LogLevel::Warning) << "Too large frame(" << frameSize << "bytes) from client(" << GetIPString(socket) << ")";
+        // 남은 데이터를 해석할 수 없으므로, 읽기 이벤트가 반복되지 않도록 바로 연결을 종료한다.
+        DisconnectClient(socket);
+        return false;
+    }
+    if (session->recvBuffer.Size() - mFrameLengthSize < frameSize)
+    {
+        return false;
+    }
+    session->recvBuffer.Consume(mFrameLengthSize);
+    session->recvBuffer.CopyTo(buf, frameSize);
+    consumeRecvBuffer(*session, frameSize);
+    ++session->iterationMessages;
+    return true;
+}
+
+bool Network::PushFrameToSendBuffer(const int32 IN socket, const char* IN data, const uint64 IN size)
+{
+    if (size > mMaxFrameSize
+        || (mFrameLengthSize < 8 && size >> (mFrameLengthSize * 8) != 0))
+    {
+        LOG(LogLevel::Warning) << "Too large frame(" << size << "bytes) to client(" << GetIPString(socket) << ")";
+        return FAILURE;
+    }
+    char header[8];
+    for (uint32 i = 0; i < mFrameLengthSize; ++i)
+    {
+        header[i] = static_cast<char>(size >> ((mFrameLengthSize - 1 - i) * 8));
+    }
+    // 길이 필드만 추가된 채로 연결이 종료되었다면 데이터는 추가하지 않는다.
+    if (PushToSendBuffer(socket, header, mFrameLengthSize) == FAILURE)
+    {
+        return FAILURE;
+    }
+    return PushToSendBuffer(socket, data, size);
+}
+
 void Network::ReserveDisconnectClient(const int32 IN socket)
 {
-    mSessions[socket].isReservedDisconnect = true;
+    struct Session* session = findSession(socket);
+    if (session != NULL)
+    {
+        session->isReservedDisconnect = true;
+    }
 }
 
 void Network::ClearRecvBuffer(const int32 IN socket)
 {
-    Session& session =  mSessions[socket];
-    session.recvBuffer.clear();
+    struct Session* session = findSession(socket);
+    if (session != NULL)
+    {
+        consumeRecvBuffer(*session, session->recvBuffer.Size());
+    }
 }
 void Network::ClearSendBuffer(const int32 IN socket)
 {
-    Session& session =  mSessions[socket];
-    session.sendBuffer.clear();
-    session.sendBufferIndex = 0;
-    session.sendBufferRemain = false;
+    struct Session* session = findSession(socket);
+    if (session != NULL)
+    {
+        session->sendBuffer.Clear();
+        session->sendBufferRemain = false;
+        releaseIdleBuffers(*session);
+        checkSendWatermark(*session);
+    }
+}
+
+void Network::BeginDrain()
+{
+    if (bIsDraining)
+    {
+        return;
+    }
+    bIsDraining = true;
+    LOG(LogLevel::Notice) << "Start draining " << mSessionCount << " sessions";
+    if (mServerSocket != ERROR)
+    {
+        // 진행 중인 accept 요청이 서버 소켓을 붙잡고 있으므로 shutdown()으로 먼저 끝낸다.
+        if (mCompletionQueue != NULL)
+        {
+            shutdown(mServerSocket, SHUT_RDWR);
+        }
+        close(mServerSocket);
+        mServerSocket = ERROR;
+    }
+    std::vector<int32> sockets;
+    sockets.reserve(mSessionCount);
+    for (std::size_t chunk = 0; chunk < mSessionChunks.size(); ++chunk)
+    {
+        for (int32 i = 0; i < kSessionChunkSize; ++i)
+        {
+            struct Session& session = mSessionChunks[chunk][i];
+            if (session.isActive)
+            {
+                session.isReservedDisconnect = true;
+                sockets.push_back(session.socket);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < sockets.size(); ++i)
+    {
+        // 한 번에 다 보냈다면 한 번 더 호출하여 연결을 종료한다.
+        if (SendToClient(sockets[i]) == SUCCESS)
+        {
+            const struct Session* session = findSession(sockets[i]);
+            if (session != NULL && session->sendBufferRemain == false)
+            {
+                SendToClient(sockets[i]);
+            }
+        }
+    }
+}
+
+bool Network::IsDrained() const
+{
+    return bIsDraining && mSessionCount == 0;
+}
+
+bool Network::IsDraining() const
+{
+    return bIsDraining;
+}
+
+bool Network::AttachCompletionQueue(CompletionQueue* IN queue)
+{
+    for (int32 i = 0; i < kAcceptSlotCount; ++i)
+    {
+        mAcceptSlots[i].addrLength = sizeof(mAcceptSlots[i].addr);
+        if (queue->PrepareAccept(mServerSocket, makeUserData(OperationAccept, i, mServerSocket),
+                                 (sockaddr*)&mAcceptSlots[i].addr, &mAcceptSlots[i].addrLength) == FAILURE)
+        {
+            LOG(LogLevel::Error) << "Failed to attach completion queue on server socket";
+            return FAILURE;
+        }
+    }
+    if (queue->Submit() == FAILURE)
+    {
+        LOG(LogLevel::Error) << "Failed to attach completion queue on server socket";
+        return FAILURE;
+    }
+    mCompletionQueue = queue;
+    return SUCCESS;
+}
+
+Network::eCompletionResult Network::HandleCompletion(const CompletionQueue::Completion& IN completion,
+                                                     int32& OUT socket)
+{
+    const uint32 operation = static_cast<uint32>(completion.userData >> 56);
+    const uint32 generation = static_cast<uint32>(completion.userData >> 32) & 0xFFFFFF;
+    socket = static_cast<int32>(completion.userData & 0xFFFFFFFF);
+    if (completion.buffer != NULL)
+    {
+        // 버퍼 풀의 버퍼는 어떤 경우에도 돌려주어야 한다. (데이터는 아래에서 먼저 복사한다)
+        struct BufferGuard
+        {
+            Network* network;
+            uint16 bufferID;
+            ~BufferGuard() { network->releaseRecvBuffer(bufferID); }
+        } guard = { this, completion.bufferID };
+        struct Session* session = findSession(socket);
+        if (operation == OperationRecv && completion.result > 0
+            && session != NULL && (session->generation & 0xFFFFFF) == generation)
+        {
+            if (session->isReservedDisconnect == false)
+            {
+                session->recvBuffer.Append(completion.buffer, static_cast<uint64>(completion.result));
+            }
+            if (completion.bHasMore == false)
+            {
+                if (session->isReadPaused)
+                {
+                    // 수신이 재개될 때 다시 등록한다.
+                    session->isRecvParked = true;
+                }
+                else
+                {
+                    mCompletionQueue->PrepareRecv(socket, completion.userData);
+                }
+            }
+            return CompletionReceived;
+        }
+    }
+    if (operation == OperationAccept)
+    {
+        struct AcceptSlot& slot = mAcceptSlots[generation % kAcceptSlotCount];
+        sockaddr_in clientAddr;
+        std::memset(&clientAddr, 0, sizeof(clientAddr));
+        if (completion.result >= 0 && slot.addrLength <= sizeof(clientAddr))
+        {
+            clientAddr = slot.addr;
+        }
+        if (completion.bHasMore == false && bIsDraining == false)
+        {
+            // 주소를 읽은 뒤 같은 슬롯으로 다음 연결을 받는다.
+            slot.addrLength = sizeof(slot.addr);
+            mCompletionQueue->PrepareAccept(mServerSocket, completion.userData,
+                                            (sockaddr*)&slot.addr, &slot.addrLength);
+        }
+        if (completion.result < 0)
+        {
+            LOG(LogLevel::Error) << "Failed to connect client on server socket"
+                << "(errno: " << -completion.result << " - " << strerror(-completion.result) << ") on io_uring accept";
+            return CompletionNone;
+        }
+        socket = completion.result;
+        if (bIsDraining)
+        {
+            close(socket);
+            return CompletionNone;
+        }
+        if (addSession(socket, clientAddr) == FAILURE)
+        {
+            return CompletionNone;
+        }
+        mCompletionQueue->PrepareRecv(socket, makeUserData(OperationRecv, findSession(socket)->generation, socket));
+        return CompletionAccepted;
+    }
+    struct Session* found = findSession(socket);
+    if (found == NULL || (found->generation & 0xFFFFFF) != generation)
+    {
+        // 이미 종료된 세션의 완료
+        if (operation == OperationSend && completion.bHasMore == false)
+        {
+            releaseOrphanSend(completion.userData);
+        }
+        return CompletionNone;
+    }
+    struct Session& session = *found;
+    if (operation == OperationRecv)
+    {
+        if (completion.result == -ENOBUFS)
+        {
+            // 버퍼 풀이 비어 multishot recv가 끝난 경우, 버퍼가 돌아올 때까지 멈춘다. (수신이 멈춘 세션은 재개될 때 등록된다)
+            session.isRecvParked = true;
+            if (session.isReadPaused == false)
+            {
+                mRecvWaitList.push_back(completion.userData);
+                resumeRecvs();
+            }
+            return CompletionNone;
+        }
+        if (completion.result < 0)
+        {
+            LOG(LogLevel::Error) << "Failed to receive message from client(" << GetIPString(socket) << ")"
+                << "(errno:" << -completion.result << " - " << strerror(-completion.result) << ") on io_uring recv";
+        }
+        DisconnectClient(socket);
+        return CompletionDisconnected;
+    }
+    // OperationSend
+    if (completion.result < 0)
+    {
+        LOG(LogLevel::Error) << "Failed to send message to client(" << GetIPString(socket) << ")"
+            << "(errno:" << -completion.result << " - " << strerror(-completion.result) << ") on io_uring send";
+        session.isSending = false;
+        DisconnectClient(socket);
+        return CompletionDisconnected;
+    }
+    session.inflight->queue.Consume(static_cast<uint64>(completion.result));
+    if (session.inflight->queue.Empty() == false)
+    {
+        struct iovec region;
+        session.inflight->queue.GetReadRegions(&region, 1);
+        mCompletionQueue->PrepareSend(socket, region.iov_base,
+                                      static_cast<uint32>(region.iov_len), completion.userData);
+        return (checkSendWatermark(session) == FAILURE) ? CompletionDisconnected : CompletionSent;
+    }
+    session.isSending = false;
+    if (submitSend(session) == FAILURE || checkSendWatermark(session) == FAILURE)
+    {
+        return CompletionDisconnected;
+    }
+    releaseIdleBuffers(session);
+    return CompletionSent;
 }
 
 int32 Network::GetServerSocket() const
@@ -202,22 +825,540 @@ int32 Network::GetServerSocket() const
     return mServerSocket;
 }
 
-const std::string Network::GetIPString(const int32 IN socket) const
+const char* Network::GetIPString(const int32 IN socket) const
 {
     if (socket == GetServerSocket())
     {
-        return mServerIPString;
+        return mServerIPString.c_str();
     }
-    if (mSessions.find(socket) != mSessions.end())
+    const struct Session* session = findSession(socket);
+    if (session != NULL)
     {
-        return inet_ntoa(mSessions.at(socket).addr.sin_addr);
+        return session->ipString;
     }
     return "Unknown client(doesn't have session))";
 }
 
 const Network::Session& Network::GetSession(const int32 IN socket) const
 {
-    return mSessions.at(socket);
+    const struct Session* session = findSession(socket);
+    if (session == NULL)
+    {
+        throw std::out_of_range("Network::GetSession");
+    }
+    return *session;
+}
+
+Network::SessionHandle Network::GetSessionHandle(const int32 IN socket) const
+{
+    const struct Session* session = findSession(socket);
+    if (session == NULL)
+    {
+        return 0;
+    }
+    return (static_cast<uint64>(session->generation) << 32) | static_cast<uint32>(socket);
+}
+
+int32 Network::GetSocket(const SessionHandle IN handle) const
+{
+    const int32 socket = static_cast<int32>(handle & 0xFFFFFFFF);
+    const struct Session* session = findSession(socket);
+    if (session == NULL || session->generation != static_cast<uint32>(handle >> 32))
+    {
+        return ERROR;
+    }
+    return socket;
+}
+
+bool Network::IsValidSession(const SessionHandle IN handle) const
+{
+    return GetSocket(handle) != ERROR;
+}
+
+uint64 Network::GetSessionCount() const
+{
+    return mSessionCount;
+}
+
+void Network::SetMessageBudget(const uint64 IN maxMessages)
+{
+    mMessageBudget = maxMessages;
+}
+
+uint64 Network::TakeCarriedSessions(std::vector<int32>& OUT sockets)
+{
+    ++mIteration;
+    uint64 count = 0;
+    for (std::size_t i = 0; i < mCarryList.size(); ++i)
+    {
+        struct Session* session = findSession(mCarryList[i]);
+        if (session == NULL || session->isCarried == false)
+        {
+            continue;
+        }
+        session->isCarried = false;
+        sockets.push_back(mCarryList[i]);
+        ++count;
+    }
+    mCarryList.clear();
+    return count;
+}
+
+bool Network::HasCarriedSessions() const
+{
+    return mCarryList.empty() == false;
+}
+
+uint64 Network::GetSessionBufferMemory(const int32 IN socket) const
+{
+    const struct Session* session = findSession(socket);
+    if (session == NULL)
+    {
+        return 0;
+    }
+    const uint64 inflightMemory = (session->inflight != NULL) ? session->inflight->queue.GetMemoryUsage() : 0;
+    return session->recvBuffer.Capacity() + session->sendBuffer.GetMemoryUsage() + inflightMemory;
+}
+
+uint64 Network::GetBufferMemory() const
+{
+    return mBufferPool.GetAllocatedMemory();
+}
+
+uint64 Network::GetPooledBufferMemory() const
+{
+    return mBufferPool.GetPooledMemory();
+}
+
+void Network::SetBufferPoolLimit(const uint64 IN limit)
+{
+    mBufferPool.SetLimit(limit);
+}
+
+bool Network::SetSendWatermarks(const uint64 IN high, const uint64 IN low, const eSlowConsumerPolicy IN policy)
+{
+    if (high != 0 && low > high)
+    {
+        LOG(LogLevel::Error) << "Invalid send watermarks(high: " << high << ", low: " << low << ")";
+        return FAILURE;
+    }
+    mSendHighWatermark = high;
+    mSendLowWatermark = low;
+    mSlowConsumerPolicy = policy;
+    return SUCCESS;
+}
+
+bool Network::SetSessionSendWatermarks(const int32 IN socket, const uint64 IN high, const uint64 IN low)
+{
+    struct Session* session = findSession(socket);
+    if (session == NULL || (high != 0 && low > high))
+    {
+        return FAILURE;
+    }
+    session->sendHighWatermark = high;
+    session->sendLowWatermark = low;
+    return checkSendWatermark(*session);
+}
+
+void Network::SetSlowConsumerHandler(SlowConsumerHandler* IN handler)
+{
+    mSlowConsumerHandler = handler;
+}
+
+uint64 Network::GetSendQueueSize(const int32 IN socket) const
+{
+    const struct Session* session = findSession(socket);
+    if (session == NULL)
+    {
+        return 0;
+    }
+    return getQueuedSize(*session);
+}
+
+bool Network::IsReadPaused(const int32 IN socket) const
+{
+    const struct Session* session = findSession(socket);
+    return session != NULL && session->isReadPaused;
+}
+
+int32 Network::acceptClient(sockaddr_in& OUT clientAddr)
+{
+    std::memset(&clientAddr, 0, sizeof(clientAddr));
+    socklen_t clientAddrLength = sizeof(clientAddr);
+#if defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+    // 수락과 non-blocking, close-on-exec 설정을 한 번의 시스템 콜로 처리한다.
+    return accept4(mServerSocket, (sockaddr*)&clientAddr, &clientAddrLength, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+    int32 clientSocket = accept(mServerSocket, (sockaddr*)&clientAddr, &clientAddrLength);
+    if (clientSocket == ERROR)
+    {
+        return ERROR;
+    }
+    // client socket non-blocking 설정
+    if (fcntl(clientSocket, F_SETFL, O_NONBLOCK) == ERROR)
+    {
+        LOG(LogLevel::Error) << "Failed to set non-blocking fd on client socket"
+            << "(errno: " << errno << " - " << strerror(errno) << ") on fcntl()";
+        close(clientSocket);
+        // 취소된 연결 요청과 같이 취급하여 ConnectNewClients()가 다음 요청을 계속 받도록 한다.
+        errno = ECONNABORTED;
+        return ERROR;
+    }
+    return clientSocket;
+#endif
+}
+
+void Network::queueFlush(struct Session& IN session)
+{
+    if (session.isFlushQueued == false)
+    {
+        session.isFlushQueued = true;
+        mFlushList.push_back(session.socket);
+    }
+}
+
+bool Network::addSession(const int32 IN clientSocket, const sockaddr_in& IN clientAddr)
+{
+    const std::size_t chunk = static_cast<std::size_t>(clientSocket) >> kSessionChunkBits;
+    while (mSessionChunks.size() <= chunk)
+    {
+        struct Session* sessions = new (std::nothrow) struct Session[kSessionChunkSize];
+        if (sessions == NULL)
+        {
+            LOG(LogLevel::Error) << "Failed to allocate session slab(socket:" << clientSocket << ") on addSession()";
+            close(clientSocket);
+            return FAILURE;
+        }
+        for (int32 i = 0; i < kSessionChunkSize; ++i)
+        {
+            sessions[i].generation = 0;
+            sessions[i].inflight = NULL;
+            sessions[i].isFlushQueued = false;
+            sessions[i].isActive = false;
+        }
+        mSessionChunks.push_back(sessions);
+    }
+    struct Session& session = mSessionChunks[chunk][clientSocket & (kSessionChunkSize - 1)];
+    if (session.isActive == false)
+    {
+        ++mSessionCount;
+    }
+    session.addr = clientAddr;
+    session.socket = clientSocket;
+    // 로그마다 주소를 변환하지 않도록 연결될 때 한 번만 문자열로 만든다.
+    if (inet_ntop(AF_INET, &clientAddr.sin_addr, session.ipString, sizeof(session.ipString)) == NULL)
+    {
+        session.ipString[0] = '\0';
+    }
+    // 버퍼의 메모리는 처음 사용할 때 풀에서 받는다.
+    session.recvBuffer.SetPool(&mBufferPool);
+    session.recvCapacityHint = 0;
+    session.scanOffset = 0;
+    session.scanDelimiterSize = 0;
+    session.peekedSize = 0;
+    session.sendBufferRemain = false;
+    session.sendBuffer.SetPool(&mBufferPool);
+    session.isReservedDisconnect = false;
+    ++session.generation;
+    if (session.generation == 0)
+    {
+        session.generation = 1;
+    }
+    session.isSending = false;
+    session.sendHighWatermark = mSendHighWatermark;
+    session.sendLowWatermark = mSendLowWatermark;
+    session.isOverHighWatermark = false;
+    session.isReadPaused = false;
+    session.isRecvParked = false;
+    session.budgetIteration = static_cast<uint32>(mIteration);
+    session.iterationMessages = 0;
+    session.isCarried = false;
+    session.isActive = true;
+    return SUCCESS;
+}
+
+void Network::removeSession(const int32 IN socket)
+{
+    struct Session* session = findSession(socket);
+    if (session == NULL)
+    {
+        return;
+    }
+    consumeRecvBuffer(*session, session->recvBuffer.Size());
+    session->sendBuffer.Clear();
+    if (session->isSending)
+    {
+        // 커널이 아직 읽고 있을 수 있으므로 완료가 도착할 때까지 데이터를 보관한다.
+        session->inflight->userData = makeUserData(OperationSend, session->generation, socket);
+        mOrphanSends.push_back(session->inflight);
+        session->inflight = NULL;
+        session->isSending = false;
+    }
+    releaseIdleBuffers(*session);
+    session->isCarried = false;
+    session->isActive = false;
+    --mSessionCount;
+}
+
+void Network::consumeRecvBuffer(struct Session& IN session, const uint64 IN size)
+{
+    session.recvBuffer.Consume(size);
+    session.scanOffset = 0;
+    session.peekedSize = 0;
+    if (session.recvBuffer.Empty())
+    {
+        session.recvBuffer.ReleaseMemory();
+    }
+}
+
+void Network::releaseOrphanSend(const uint64 IN userData)
+{
+    for (std::size_t i = 0; i < mOrphanSends.size(); ++i)
+    {
+        if (mOrphanSends[i]->userData != userData)
+        {
+            continue;
+        }
+        struct InflightSend* orphan = mOrphanSends[i];
+        mOrphanSends[i] = mOrphanSends.back();
+        mOrphanSends.pop_back();
+        releaseInflightSend(orphan);
+        return;
+    }
+}
+
+void Network::releaseIdleBuffers(struct Session& IN session)
+{
+    session.recvBuffer.ReleaseMemory();
+    session.sendBuffer.ReleaseMemory();
+    // 커널이 읽고 있는 데이터는 완료가 도착할 때까지 유지한다.
+    if (session.isSending == false && session.inflight != NULL)
+    {
+        releaseInflightSend(session.inflight);
+        session.inflight = NULL;
+    }
+}
+
+struct Network::InflightSend* Network::acquireInflightSend()
+{
+    if (mFreeInflightSends.empty())
+    {
+        struct InflightSend* inflight = new struct InflightSend;
+        inflight->queue.SetPool(&mBufferPool);
+        return inflight;
+    }
+    struct InflightSend* inflight = mFreeInflightSends.back();
+    mFreeInflightSends.pop_back();
+    return inflight;
+}
+
+void Network::releaseInflightSend(struct InflightSend* IN inflight)
+{
+    inflight->queue.Clear();
+    inflight->queue.ReleaseMemory();
+    mFreeInflightSends.push_back(inflight);
+}
+
+uint64 Network::getQueuedSize(const struct Session& IN session)
+{
+    const uint64 inflightSize = (session.inflight != NULL) ? session.inflight->queue.Size() : 0;
+    return session.sendBuffer.Size() + inflightSize;
+}
+
+void Network::updateScanDelimiter(struct Session& IN OUT session, const std::string& IN endString)
+{
+    // 같은 구분자라면 이전 호출에서 이미 확인한 부분은 다시 찾지 않는다.
+    if (session.scanDelimiterSize != 0 && session.scanDelimiterSize == endString.size()
+        && std::memcmp(session.scanDelimiter, endString.data(), endString.size()) == 0)
+    {
+        return;
+    }
+    session.scanOffset = 0;
+    if (endString.size() > kMaxScanDelimiterSize)
+    {
+        session.scanDelimiterSize = 0;
+        return;
+    }
+    std::memcpy(session.scanDelimiter, endString.data(), endString.size());
+    session.scanDelimiterSize = static_cast<uint8>(endString.size());
+}
+
+uint64 Network::getMessageBudget(struct Session& IN session)
+{
+    if (mMessageBudget == 0)
+    {
+        return ~static_cast<uint64>(0);
+    }
+    // 새 바퀴가 시작된 뒤 처음 확인하는 세션이라면 가져온 메세지의 개수를 초기화한다.
+    if (session.budgetIteration != static_cast<uint32>(mIteration))
+    {
+        session.budgetIteration = static_cast<uint32>(mIteration);
+        session.iterationMessages = 0;
+    }
+    const uint64 budget = (session.iterationMessages < mMessageBudget) ? mMessageBudget - session.iterationMessages : 0;
+    if (budget == 0 && session.recvBuffer.Empty() == false)
+    {
+        carrySession(session);
+    }
+    return budget;
+}
+
+void Network::carrySession(struct Session& IN session)
+{
+    if (session.isCarried == false)
+    {
+        session.isCarried = true;
+        mCarryList.push_back(session.socket);
+    }
+}
+
+bool Network::checkSendWatermark(struct Session& IN session)
+{
+    const uint64 queuedSize = getQueuedSize(session);
+    if (session.isOverHighWatermark == false)
+    {
+        if (session.sendHighWatermark == 0 || queuedSize <= session.sendHighWatermark)
+        {
+            return SUCCESS;
+        }
+        session.isOverHighWatermark = true;
+        const int32 socket = session.socket;
+        LOG(LogLevel::Warning) << "Client(" << GetIPString(socket) << ") send queue exceeded high watermark("
+            << queuedSize << "bytes)";
+        // 준비 상태 통지 모드에서는 처리기가 읽기 이벤트를 꺼야 하므로, 처리기가 없다면 수신을 멈추지 않는다.
+        // (level-triggered로 감시 중인 소켓을 읽지 않으면 같은 읽기 이벤트가 계속 발생한다)
+        if (mSlowConsumerPolicy == SlowConsumerPauseReads
+            && (mCompletionQueue != NULL || mSlowConsumerHandler != NULL))
+        {
+            session.isReadPaused = true;
+        }
+        if (mSlowConsumerHandler != NULL)
+        {
+            mSlowConsumerHandler->OnSendHighWatermark(*this, socket, queuedSize);
+        }
+        // 처리기 안에서 연결을 종료했을 수 있다.
+        if (findSession(socket) == NULL)
+        {
+            return FAILURE;
+        }
+        if (mSlowConsumerPolicy == SlowConsumerDisconnect)
+        {
+            DisconnectClient(socket);
+            return FAILURE;
+        }
+        return SUCCESS;
+    }
+    if (queuedSize > session.sendLowWatermark)
+    {
+        return SUCCESS;
+    }
+    session.isOverHighWatermark = false;
+    if (session.isReadPaused)
+    {
+        session.isReadPaused = false;
+        if (session.isRecvParked)
+        {
+            session.isRecvParked = false;
+            mCompletionQueue->PrepareRecv(session.socket, makeUserData(OperationRecv, session.generation, session.socket));
+        }
+    }
+    if (mSlowConsumerHandler != NULL)
+    {
+        mSlowConsumerHandler->OnSendLowWatermark(*this, session.socket, queuedSize);
+    }
+    return SUCCESS;
+}
+
+struct Network::Session* Network::findSession(const int32 IN socket)
+{
+    const std::size_t chunk = static_cast<std::size_t>(socket) >> kSessionChunkBits;
+    if (socket < 0 || chunk >= mSessionChunks.size())
+    {
+        return NULL;
+    }
+    struct Session* session = &mSessionChunks[chunk][socket & (kSessionChunkSize - 1)];
+    return session->isActive ? session : NULL;
+}
+
+const struct Network::Session* Network::findSession(const int32 IN socket) const
+{
+    return const_cast<Network*>(this)->findSession(socket);
+}
+
+bool Network::submitSend(struct Session& IN session)
+{
+    if (session.isSending)
+    {
+        return SUCCESS;
+    }
+    if (session.sendBufferRemain == false)
+    {
+        if (session.isReservedDisconnect)
+        {
+            DisconnectClient(session.socket);
+            return FAILURE;
+        }
+        return SUCCESS;
+    }
+    if (session.inflight == NULL)
+    {
+        session.inflight = acquireInflightSend();
+    }
+    session.inflight->queue.Clear();
+    session.inflight->queue.Swap(session.sendBuffer);
+    session.sendBufferRemain = false;
+    // send 요청은 연속된 구간 하나씩 보내며, 남은 구간은 완료가 도착할 때마다 이어서 보낸다.
+    struct iovec region;
+    session.inflight->queue.GetReadRegions(&region, 1);
+    if (mCompletionQueue->PrepareSend(session.socket, region.iov_base,
+                                      static_cast<uint32>(region.iov_len),
+                                      makeUserData(OperationSend, session.generation, session.socket)) == FAILURE)
+    {
+        // 제출 큐에 자리가 없다면 데이터를 되돌려 다음 SendToClient()에서 다시 시도한다.
+        session.sendBuffer.Swap(session.inflight->queue);
+        session.sendBufferRemain = true;
+        return SUCCESS;
+    }
+    session.isSending = true;
+    return SUCCESS;
+}
+
+void Network::releaseRecvBuffer(const uint16 IN bufferID)
+{
+    mCompletionQueue->ReleaseBuffer(bufferID);
+    if (mRecvWaitList.empty() == false)
+    {
+        resumeRecvs();
+    }
+}
+
+void Network::resumeRecvs()
+{
+    uint32 available = mCompletionQueue->GetAvailableBufferCount();
+    std::size_t count = 0;
+    while (count < mRecvWaitList.size() && available > 0)
+    {
+        const uint64 userData = mRecvWaitList[count];
+        ++count;
+        const int32 socket = static_cast<int32>(userData & 0xFFFFFFFF);
+        struct Session* session = findSession(socket);
+        // 이미 종료되었거나, 수신이 멈추었거나, 다른 경로로 다시 등록된 세션은 건너뛴다.
+        if (session == NULL || (session->generation & 0xFFFFFF) != ((userData >> 32) & 0xFFFFFF)
+            || session->isRecvParked == false || session->isReadPaused)
+        {
+            continue;
+        }
+        session->isRecvParked = false;
+        mCompletionQueue->PrepareRecv(socket, userData);
+        --available;
+    }
+    mRecvWaitList.erase(mRecvWaitList.begin(), mRecvWaitList.begin() + count);
+}
+
+uint64 Network::makeUserData(const uint32 IN operation, const uint32 IN generation, const int32 IN socket)
+{
+    return (static_cast<uint64>(operation) << 56) | (static_cast<uint64>(generation & 0xFFFFFF) << 32)
+           | static_cast<uint32>(socket);
 }
 
 bool Network::createServerSocket()
@@ -232,7 +1373,7 @@ bool Network::createServerSocket()
     return SUCCESS;
 }
 
-bool Network::setServerSocket(const int32 IN port)
+bool Network::setServerSocket(const int32 IN port, const bool IN bReusePort)
 {
     int32 reuseOption = 1; // socket 사용 후, 다시 사용하기 까지의 delay 제거(개발자 테스트 편의용)
     int32 keepaliveOption = 1; // 상대방과 연결이 끊어졌는지 60초마다 확인 (TCP 연결 2시간 뒤부터 keepalive 메세지 전송 시작)
@@ -247,6 +1388,22 @@ bool Network::setServerSocket(const int32 IN port)
             << "(errno:" << errno << " - " << strerror(errno) << ") on setsockopt()";
         return FAILURE;
     }
+    // 같은 port를 공유하는 서버 소켓들에 커널이 새 연결을 분배하도록 설정 (multi-reactor 용)
+    if (bReusePort)
+    {
+        int32 reusePortOption = 1;
+#if defined(SO_REUSEPORT_LB)
+        const int32 reusePortName = SO_REUSEPORT_LB;
+#else
+        const int32 reusePortName = SO_REUSEPORT;
+#endif
+        if (setsockopt(mServerSocket, SOL_SOCKET, reusePortName, &reusePortOption, sizeof(reusePortOption)) == ERROR)
+        {
+            LOG(LogLevel::Error) << "Failed to set reuse port option on server socket"
+                << "(errno:" << errno << " - " << strerror(errno) << ") on setsockopt()";
+            return FAILURE;
+        }
+    }
     // server socket non-blocking 설정
     if (fcntl(mServerSocket, F_SETFL, O_NONBLOCK) == ERROR)
     {
@@ -0,0 +1,266 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "BSD-GDF/Network/ReactorGroup.hpp"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace gdf
+{
+
+Reactor::Reactor()
+: mGroup(NULL)
+, mIndex(0)
+, bIsRunning(false)
+{
+
+}
+
+Reactor::~Reactor()
+{
+
+}
+
+KernelQueue& Reactor::GetKernelQueue()
+{
+    return mKernelQueue;
+}
+
+Network& Reactor::GetNetwork()
+{
+    return mNetwork;
+}
+
+int32 Reactor::GetIndex() const
+{
+    return mIndex;
+}
+
+void ReactorHandler::OnAccept(Reactor& IN reactor, const int32 IN socket)
+{
+    (void)reactor;
+    (void)socket;
+}
+
+void ReactorHandler::OnCarriedSession(Reactor& IN reactor, const int32 IN socket)
+{
+    (void)reactor;
+    (void)socket;
+}
+
+ReactorGroup::ReactorGroup()
+: mHandler(NULL)
+, mStopRequested(0)
+{
+
+}
+
+ReactorGroup::~ReactorGroup()
+{
+    Stop();
+    Join();
+    release();
+}
+
+bool ReactorGroup::Init(const int32 IN port, ReactorHandler* IN handler, const int32 IN reactorCount)
+{
+    int32 count = reactorCount;
+    if (count <= 0)
+    {
+        count = static_cast<int32>(sysconf(_SC_NPROCESSORS_ONLN));
+        if (count <= 0)
+        {
+            count = 1;
+        }
+    }
+    if (handler == NULL)
+    {
+        LOG(LogLevel::Error) << "Reactor handler must not be NULL";
+        return FAILURE;
+    }
+    mHandler = handler;
+    for (int32 i = 0; i < count; ++i)
+    {
+        Reactor* reactor = new Reactor();
+        reactor->mGroup = this;
+        reactor->mIndex = i;
+        mReactors.push_back(reactor);
+        if (reactor->mKernelQueue.Init() == FAILURE
+            || reactor->mNetwork.Init(port, true) == FAILURE
+            || reactor->mKernelQueue.AddReadEvent(reactor->mNetwork.GetServerSocket()) == FAILURE)
+        {
+            LOG(LogLevel::Error) << "Failed to initialize reactor " << i;
+            release();
+            return FAILURE;
+        }
+    }
+    return SUCCESS;
+}
+
+bool ReactorGroup::Start()
+{
+    __atomic_store_n(&mStopRequested, 0, __ATOMIC_RELEASE);
+    for (std::size_t i = 0; i < mReactors.size(); ++i)
+    {
+        Reactor& reactor = *mReactors[i];
+        if (pthread_create(&reactor.mThread, NULL, runThread, &reactor) != 0)
+        {
+            LOG(LogLevel::Error) << "Failed to create thread for reactor " << i;
+            Stop();
+            Join();
+            return FAILURE;
+        }
+        reactor.bIsRunning = true;
+    }
+    return SUCCESS;
+}
+
+void ReactorGroup::Stop()
+{
+    __atomic_store_n(&mStopRequested, 1, __ATOMIC_RELEASE);
+    for (std::size_t i = 0; i < mReactors.size(); ++i)
+    {
+        if (mReactors[i]->bIsRunning)
+        {
+            mReactors[i]->mKernelQueue.Wakeup();
+        }
+    }
+}
+
+void ReactorGroup::Join()
+{
+    for (std::size_t i = 0; i < mReactors.size(); ++i)
+    {
+        if (mReactors[i]->bIsRunning)
+        {
+            pthread_join(mReactors[i]->mThread, NULL);
+            mReactors[i]->bIsRunning = false;
+        }
+    }
+}
+
+int32 ReactorGroup::GetReactorCount() const
+{
+    return static_cast<int32>(mReactors.size());
+}
+
+Reactor& ReactorGroup::GetReactor(const int32 IN index)
+{
+    return *mReactors[index];
+}
+
+void* ReactorGroup::runThread(void* arg)
+{
+    Reactor* reactor = static_cast<Reactor*>(arg);
+    reactor->mGroup->run(*reactor);
+    return NULL;
+}
+
+void ReactorGroup::run(Reactor& reactor)
+{
+#if defined(__linux__)
+    // 스레드를 한 CPU에 고정하여 세션 데이터가 같은 캐시에 머물도록 한다.
+    const long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpuCount > 0)
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(reactor.mIndex % cpuCount, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    }
+#endif
+    KernelQueue& kernelQueue = reactor.mKernelQueue;
+    Network& network = reactor.mNetwork;
+    const int32 serverSocket = network.GetServerSocket();
+    KernelEvent event;
+    std::vector<int32> clientSockets;
+    std::vector<int32> carriedSockets;
+    int64 timeout = kernelQueue.GetTimeout();
+    bool bIsNoWait = false;
+    while (__atomic_load_n(&mStopRequested, __ATOMIC_ACQUIRE) == 0)
+    {
+        if (kernelQueue.HasPendingEvents() == false)
+        {
+            // 한 바퀴의 이벤트를 다 처리했으므로, 다음 대기 전에 이전 바퀴에서 budget을 다 쓴 세션들을 이어서 처리한다.
+            carriedSockets.clear();
+            network.TakeCarriedSessions(carriedSockets);
+            for (std::size_t i = 0; i < carriedSockets.size(); ++i)
+            {
+                mHandler->OnCarriedSession(reactor, carriedSockets[i]);
+            }
+            // 추가된 데이터를 세션마다 한 번에 보낸다.
+            network.FlushSendBuffers();
+            // 넘겨진 세션이 남아있다면 데이터가 이미 도착해 있으므로 기다리지 않는다.
+            if (network.HasCarriedSessions())
+            {
+                if (bIsNoWait == false)
+                {
+                    timeout = kernelQueue.GetTimeout();
+                    kernelQueue.SetTimeout(0);
+                    bIsNoWait = true;
+                }
+            }
+            else if (bIsNoWait)
+            {
+                kernelQueue.SetTimeout(timeout);
+                bIsNoWait = false;
+            }
+        }
+        // Poll()이 false를 반환하면 한 바퀴의 이벤트를 다 꺼낸 뒤 다시 기다린 것이다.
+        if (kernelQueue.Poll(event) == false)
+        {
+            continue;
+        }
+        if (event.IdentifySocket(serverSocket) && event.IsReadType() && !event.IsTimerType())
+        {
+            // 대기 중인 연결 요청을 한 번에 수락한다.
+            clientSockets.clear();
+            network.ConnectNewClients(clientSockets);
+            for (std::size_t i = 0; i < clientSockets.size(); ++i)
+            {
+                if (kernelQueue.AddReadEvent(clientSockets[i]) == FAILURE)
+                {
+                    network.DisconnectClient(clientSockets[i]);
+                    clientSockets[i] = ERROR;
+                }
+            }
+            // 등록은 다음 대기에서야 적용되므로, 실패한 소켓을 알 수 있도록 여기서 제출한다.
+            if (clientSockets.empty() == false && kernelQueue.Flush() == FAILURE)
+            {
+                // 어느 등록이 실패했는지 알 수 없으므로 하나씩 다시 등록해 본다.
+                for (std::size_t i = 0; i < clientSockets.size(); ++i)
+                {
+                    if (clientSockets[i] != ERROR
+                        && (kernelQueue.AddReadEvent(clientSockets[i]) == FAILURE || kernelQueue.Flush() == FAILURE))
+                    {
+                        network.DisconnectClient(clientSockets[i]);
+                        clientSockets[i] = ERROR;
+                    }
+                }
+            }
+            for (std::size_t i = 0; i < clientSockets.size(); ++i)
+            {
+                if (clientSockets[i] != ERROR)
+                {
+                    mHandler->OnAccept(reactor, clientSockets[i]);
+                }
+            }
+            continue;
+        }
+        mHandler->OnEvent(reactor, event);
+    }
+}
+
+void ReactorGroup::release()
+{
+    for (std::size_t i = 0; i < mReactors.size(); ++i)
+    {
+        delete mReactors[i];
+    }
+    mReactors.clear();
+}
+
+}
@@ -0,0 +1,203 @@
+#include "BSD-GDF/Network/SendQueue.hpp"
+
+namespace gdf
+{
+
+namespace
+{
+    /**
+     * 다 보낸 세그먼트가 이 개수를 넘으면 목록 앞에서 지운다.
+     */
+    const uint64 kSegmentCompactThreshold = 64;
+}
+
+SendQueue::SendQueue()
+: mSegmentHead(0)
+, mSize(0)
+{
+
+}
+
+SendQueue::~SendQueue()
+{
+
+}
+
+void SendQueue::Append(const char* IN data, const uint64 IN size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    mBytes.Append(data, size);
+    mSize += size;
+    if (mSegments.empty())
+    {
+        return;
+    }
+    // 앞선 데이터가 SharedBuffer라면 순서를 지키기 위해 새 세그먼트를 만든다.
+    if (mSegments.back().buffer.Empty())
+    {
+        mSegments.back().size += size;
+        return;
+    }
+    Segment segment;
+    segment.offset = 0;
+    segment.size = size;
+    mSegments.push_back(segment);
+}
+
+void SendQueue::Append(const SharedBuffer& IN buffer)
+{
+    if (buffer.Empty())
+    {
+        return;
+    }
+    if (mSegments.empty() && mBytes.Empty() == false)
+    {
+        Segment segment;
+        segment.offset = 0;
+        segment.size = mBytes.Size();
+        mSegments.push_back(segment);
+    }
+    Segment segment;
+    segment.buffer = buffer;
+    segment.offset = 0;
+    segment.size = buffer.Size();
+    mSegments.push_back(segment);
+    mSize += buffer.Size();
+}
+
+void SendQueue::Consume(const uint64 IN size)
+{
+    if (size >= mSize)
+    {
+        Clear();
+        return;
+    }
+    mSize -= size;
+    if (mSegments.empty())
+    {
+        mBytes.Consume(size);
+        return;
+    }
+    uint64 remain = size;
+    while (remain > 0)
+    {
+        Segment& segment = mSegments[mSegmentHead];
+        const uint64 length = (remain < segment.size) ? remain : segment.size;
+        if (segment.buffer.Empty())
+        {
+            mBytes.Consume(length);
+        }
+        else
+        {
+            segment.offset += length;
+        }
+        segment.size -= length;
+        remain -= length;
+        if (segment.size == 0)
+        {
+            segment.buffer = SharedBuffer();
+            ++mSegmentHead;
+        }
+    }
+    if (mSegmentHead >= kSegmentCompactThreshold && mSegmentHead * 2 >= mSegments.size())
+    {
+        mSegments.erase(mSegments.begin(), mSegments.begin() + mSegmentHead);
+        mSegmentHead = 0;
+    }
+}
+
+void SendQueue::Clear()
+{
+    mBytes.Clear();
+    mSegments.clear();
+    mSegmentHead = 0;
+    mSize = 0;
+}
+
+void SendQueue::Reserve(const uint64 IN capacity)
+{
+    mBytes.Reserve(capacity);
+}
+
+void SendQueue::Swap(SendQueue& IN OUT queue)
+{
+    mBytes.Swap(queue.mBytes);
+    mSegments.swap(queue.mSegments);
+    const uint64 segmentHead = mSegmentHead;
+    const uint64 size = mSize;
+    mSegmentHead = queue.mSegmentHead;
+    mSize = queue.mSize;
+    queue.mSegmentHead = segmentHead;
+    queue.mSize = size;
+}
+
+void SendQueue::SetPool(BufferPool* IN pool)
+{
+    mBytes.SetPool(pool);
+}
+
+void SendQueue::ReleaseMemory()
+{
+    if (mSize != 0)
+    {
+        return;
+    }
+    mBytes.ReleaseMemory();
+    std::vector<Segment>().swap(mSegments);
+    mSegmentHead = 0;
+}
+
+uint64 SendQueue::GetMemoryUsage() const
+{
+    return mBytes.Capacity() + mSegments.capacity() * sizeof(Segment);
+}
+
+uint64 SendQueue::Size() const
+{
+    return mSize;
+}
+
+bool SendQueue::Empty() const
+{
+    return mSize == 0;
+}
+
+uint32 SendQueue::GetReadRegions(struct iovec* OUT regions, const uint32 IN count) const
+{
+    if (mSegments.empty())
+    {
+        const uint64 length = (count >= 2) ? mBytes.Size() : mBytes.GetContiguousSize();
+        return mBytes.GetReadRegions(regions, 0, length);
+    }
+    uint32 filled = 0;
+    uint64 bytesOffset = 0;
+    for (uint64 i = mSegmentHead; i < mSegments.size() && filled < count; ++i)
+    {
+        const Segment& segment = mSegments[i];
+        if (segment.buffer.Empty() == false)
+        {
+            regions[filled].iov_base = const_cast<char*>(segment.buffer.GetData() + segment.offset);
+            regions[filled].iov_len = segment.size;
+            ++filled;
+            continue;
+        }
+        // 복사된 데이터는 링 버퍼의 끝에서 나뉘어 두 구간이 될 수 있다.
+        struct iovec parts[2];
+        const uint32 partCount = mBytes.GetReadRegions(parts, bytesOffset, segment.size);
+        for (uint32 part = 0; part < partCount && filled < count; ++part)
+        {
+            regions[filled++] = parts[part];
+        }
+        if (filled == count)
+        {
+            break;
+        }
+        bytesOffset += segment.size;
+    }
+    return filled;
+}
+
+}
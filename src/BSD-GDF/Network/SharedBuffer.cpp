@@ -0,0 +1,95 @@
+#include "BSD-GDF/Network/SharedBuffer.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+namespace gdf
+{
+
+SharedBuffer::SharedBuffer()
+: mBlock(NULL)
+{
+
+}
+
+SharedBuffer::SharedBuffer(const char* IN data, const uint64 IN size)
+: mBlock(NULL)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    // 참조 횟수와 데이터를 한 번의 할당으로 만든다.
+    mBlock = static_cast<Block*>(::operator new(offsetof(Block, data) + size));
+    mBlock->referenceCount = 1;
+    mBlock->size = size;
+    std::memcpy(mBlock->data, data, size);
+}
+
+SharedBuffer::SharedBuffer(const std::string& IN data)
+: mBlock(NULL)
+{
+    SharedBuffer buffer(data.data(), data.size());
+    *this = buffer;
+}
+
+SharedBuffer::SharedBuffer(const SharedBuffer& buffer)
+: mBlock(buffer.mBlock)
+{
+    if (mBlock != NULL)
+    {
+        __atomic_add_fetch(&mBlock->referenceCount, 1, __ATOMIC_RELAXED);
+    }
+}
+
+SharedBuffer& SharedBuffer::operator=(const SharedBuffer& buffer)
+{
+    if (mBlock == buffer.mBlock)
+    {
+        return *this;
+    }
+    if (buffer.mBlock != NULL)
+    {
+        __atomic_add_fetch(&buffer.mBlock->referenceCount, 1, __ATOMIC_RELAXED);
+    }
+    release();
+    mBlock = buffer.mBlock;
+    return *this;
+}
+
+SharedBuffer::~SharedBuffer()
+{
+    release();
+}
+
+const char* SharedBuffer::GetData() const
+{
+    return (mBlock == NULL) ? NULL : mBlock->data;
+}
+
+uint64 SharedBuffer::Size() const
+{
+    return (mBlock == NULL) ? 0 : mBlock->size;
+}
+
+bool SharedBuffer::Empty() const
+{
+    return mBlock == NULL;
+}
+
+uint64 SharedBuffer::GetReferenceCount() const
+{
+    return (mBlock == NULL) ? 0 : __atomic_load_n(&mBlock->referenceCount, __ATOMIC_RELAXED);
+}
+
+void SharedBuffer::release()
+{
+    if (mBlock != NULL && __atomic_sub_fetch(&mBlock->referenceCount, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        ::operator delete(mBlock);
+    }
+    mBlock = NULL;
+}
+
+}